@@ -0,0 +1,53 @@
+# SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+# SPDX-License-Identifier: CC0-1.0
+"""Gera main/pilhas_geradas.h a partir do perfil de pilhas (PERFIL_PILHAS=1).
+
+O firmware emite o cabeçalho entre marcadores [PILHAS] na saída serial; este
+script grava o último cabeçalho completo da captura. Depois, compile com
+PILHAS_GERADAS=1 para aplicar os tamanhos recomendados.
+
+Uso:
+    python gerar_pilhas.py captura.txt
+    python gerar_pilhas.py captura.txt -o main/pilhas_geradas.h
+"""
+import argparse
+import pathlib
+import sys
+from typing import Iterable, List, Optional
+
+INICIO = '[PILHAS] ---- início de pilhas_geradas.h ----'
+FIM = '[PILHAS] ---- fim ----'
+PREFIXO = '[PILHAS] '
+
+
+def extrair(linhas: Iterable[str]) -> Optional[List[str]]:
+    ultimo = None
+    atual = None
+    for linha in linhas:
+        if INICIO in linha:
+            atual = []
+        elif FIM in linha and atual is not None:
+            ultimo = atual
+            atual = None
+        elif atual is not None and PREFIXO in linha:
+            atual.append(linha.split(PREFIXO, 1)[1].rstrip())
+    return ultimo
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description='Gera pilhas_geradas.h a partir da saída do perfil de pilhas')
+    parser.add_argument('captura', help='saída serial com o perfil de pilhas')
+    parser.add_argument('-o', '--saida', default=str(pathlib.Path(__file__).parent / 'main' / 'pilhas_geradas.h'))
+    args = parser.parse_args()
+
+    with open(args.captura, encoding='utf-8', errors='replace') as f:
+        cabecalho = extrair(f)
+    if not cabecalho:
+        sys.exit('Nenhum cabeçalho [PILHAS] completo na captura')
+
+    pathlib.Path(args.saida).write_text('\n'.join(cabecalho) + '\n', encoding='utf-8')
+    print(f'{args.saida}: {len(cabecalho)} linhas')
+
+
+if __name__ == '__main__':
+    main()
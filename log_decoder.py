@@ -0,0 +1,268 @@
+# SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+# SPDX-License-Identifier: CC0-1.0
+"""Decodificador do log binário (LOG_MODO_BINARIO, main/log_binario.c).
+
+O dispositivo envia quadros COBS terminados em 0x00 com o ID do formato e os
+argumentos crus. As strings de formato não trafegam: os quadros DEF trazem o
+endereço da string, que é lido de build/hello_world.elf.
+
+Uso:
+    python log_decoder.py build/hello_world.elf captura.bin
+    python log_decoder.py build/hello_world.elf --port /dev/ttyUSB0
+"""
+import argparse
+import re
+import struct
+import sys
+from typing import Callable, Dict, Iterator, List, Optional, Tuple
+
+ID_DEF = 0
+ID_TEXTO = 1
+
+ESPECIFICADOR = re.compile(r'%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|z|j|t|L)?([diuxXocpfegs%])')
+
+
+# ==========================================
+# Enquadramento (espelho de escrever_quadro em log_binario.c)
+def crc8(dados: bytes) -> int:
+    crc = 0
+    for b in dados:
+        crc ^= b
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def cobs_codificar(dados: bytes) -> bytes:
+    saida = bytearray([0])
+    codigo = 0
+    for b in dados:
+        if b != 0:
+            saida.append(b)
+        if b == 0 or len(saida) - codigo == 0xFF:
+            saida[codigo] = len(saida) - codigo
+            codigo = len(saida)
+            saida.append(0)
+    saida[codigo] = len(saida) - codigo
+    return bytes(saida)
+
+
+def cobs_decodificar(dados: bytes) -> Optional[bytes]:
+    saida = bytearray()
+    i = 0
+    while i < len(dados):
+        codigo = dados[i]
+        if codigo == 0 or i + codigo > len(dados):
+            return None
+        saida += dados[i + 1:i + codigo]
+        i += codigo
+        if codigo < 0xFF and i < len(dados):
+            saida.append(0)
+    return bytes(saida)
+
+
+def codificar_quadro(payload: bytes) -> bytes:
+    """Quadro completo como o dispositivo envia (usado nos testes)."""
+    return cobs_codificar(payload + bytes([crc8(payload)])) + b'\x00'
+
+
+# ==========================================
+# Leitura de argumentos
+def ler_varint(dados: bytes, pos: int) -> Tuple[int, int]:
+    valor = 0
+    deslocamento = 0
+    while True:
+        b = dados[pos]
+        pos += 1
+        valor |= (b & 0x7F) << deslocamento
+        deslocamento += 7
+        if b < 0x80:
+            return valor, pos
+
+
+def escrever_varint(valor: int) -> bytes:
+    saida = bytearray()
+    while valor >= 0x80:
+        saida.append((valor & 0x7F) | 0x80)
+        valor >>= 7
+    saida.append(valor)
+    return bytes(saida)
+
+
+def zigzag_decodificar(v: int) -> int:
+    return (v >> 1) ^ -(v & 1)
+
+
+def formatar(fmt: str, args: bytes) -> str:
+    """Aplica os argumentos crus ao formato C, na mesma ordem em que o dispositivo os serializou."""
+    pos = 0
+
+    def proximo_int() -> int:
+        nonlocal pos
+        v, pos = ler_varint(args, pos)
+        return zigzag_decodificar(v)
+
+    def substituir(m: 're.Match[str]') -> str:
+        nonlocal pos
+        flags, largura, precisao, _, conv = m.groups()
+        if conv == '%':
+            return '%'
+        if largura == '*':
+            largura = str(proximo_int())
+        if precisao == '*':
+            precisao = str(proximo_int())
+        spec = '%' + flags + (largura or '') + ('.' + precisao if precisao is not None else '')
+
+        if conv in 'di':
+            return (spec + 'd') % proximo_int()
+        if conv in 'uxXo':
+            v, pos = ler_varint(args, pos)
+            return (spec + ('d' if conv == 'u' else conv)) % v
+        if conv == 'c':
+            v, pos = ler_varint(args, pos)
+            return (spec + 'c') % chr(v)
+        if conv == 'p':
+            v, pos = ler_varint(args, pos)
+            return '0x%x' % v
+        if conv in 'feg':
+            (v,) = struct.unpack_from('<d', args, pos)
+            pos += 8
+            return (spec + conv) % v
+        n, pos = ler_varint(args, pos)
+        texto = args[pos:pos + n].decode('utf-8', 'replace')
+        pos += n
+        return (spec + 's') % texto
+
+    return ESPECIFICADOR.sub(substituir, fmt)
+
+
+# ==========================================
+# Decodificador de fluxo
+class DecodificadorLog:
+    def __init__(self, resolver: Callable[[int], str]) -> None:
+        self.resolver = resolver
+        self.formatos: Dict[int, str] = {}
+        self.pendente = bytearray()
+        self.bytes_recebidos = 0
+        self.bytes_texto = 0
+        self.registros = 0
+        self.erros = 0
+
+    def alimentar(self, dados: bytes) -> Iterator[str]:
+        """Consome bytes da serial e produz as linhas de texto reconstruídas."""
+        self.bytes_recebidos += len(dados)
+        self.pendente += dados
+        while True:
+            fim = self.pendente.find(b'\x00')
+            if fim < 0:
+                return
+            bloco = bytes(self.pendente[:fim])
+            del self.pendente[:fim + 1]
+            if bloco:
+                yield from self._processar_bloco(bloco)
+
+    def _processar_bloco(self, bloco: bytes) -> Iterator[str]:
+        payload = self._validar(bloco)
+        if payload is None and b'\n' in bloco:
+            # Texto comum (ESP_LOG, panic) seguido de um quadro no mesmo bloco
+            corte = bloco.rindex(b'\n') + 1
+            texto, bloco = bloco[:corte], bloco[corte:]
+            yield texto.decode('utf-8', 'replace')
+            payload = self._validar(bloco) if bloco else None
+            if not bloco:
+                return
+        if payload is None:
+            self.erros += 1
+            yield bloco.decode('utf-8', 'replace')
+            return
+
+        id_fmt, pos = ler_varint(payload, 0)
+        if id_fmt == ID_DEF:
+            novo_id, pos = ler_varint(payload, pos)
+            (endereco,) = struct.unpack_from('<I', payload, pos)
+            self.formatos[novo_id] = self.resolver(endereco)
+            return
+
+        if id_fmt == ID_TEXTO:
+            linha = payload[pos:].decode('utf-8', 'replace')
+        elif id_fmt in self.formatos:
+            linha = formatar(self.formatos[id_fmt], payload[pos:])
+        else:
+            linha = '[log_decoder] formato %d ainda não anunciado\n' % id_fmt
+        self.registros += 1
+        self.bytes_texto += len(linha.encode('utf-8'))
+        yield linha
+
+    @staticmethod
+    def _validar(bloco: bytes) -> Optional[bytes]:
+        dados = cobs_decodificar(bloco)
+        if dados is None or len(dados) < 2 or crc8(dados[:-1]) != dados[-1]:
+            return None
+        return dados[:-1]
+
+    def reducao(self) -> float:
+        """Bytes de texto reconstruídos por byte recebido no fio."""
+        return self.bytes_texto / self.bytes_recebidos if self.bytes_recebidos else 0.0
+
+
+# ==========================================
+# Strings de formato a partir do ELF
+def resolver_elf(caminho_elf: str) -> Callable[[int], str]:
+    from elftools.elf.elffile import ELFFile
+
+    secoes: List[Tuple[int, bytes]] = []
+    with open(caminho_elf, 'rb') as f:
+        elf = ELFFile(f)
+        for secao in elf.iter_sections():
+            # Apenas seções carregadas com conteúdo (ex.: .flash.rodata)
+            if secao['sh_flags'] & 0x2 and secao['sh_type'] == 'SHT_PROGBITS':
+                secoes.append((secao['sh_addr'], secao.data()))
+
+    def resolver(endereco: int) -> str:
+        for inicio, dados in secoes:
+            if inicio <= endereco < inicio + len(dados):
+                deslocamento = endereco - inicio
+                fim = dados.find(b'\x00', deslocamento)
+                return dados[deslocamento:fim].decode('utf-8', 'replace')
+        return '[log_decoder] endereço 0x%08x fora do ELF\n' % endereco
+
+    return resolver
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('elf', help='build/hello_world.elf do firmware em execução')
+    parser.add_argument('captura', nargs='?', help='arquivo com bytes capturados (padrão: stdin)')
+    parser.add_argument('--port', help='porta serial (requer pyserial)')
+    parser.add_argument('--baud', type=int, default=115200)
+    args = parser.parse_args()
+
+    decodificador = DecodificadorLog(resolver_elf(args.elf))
+
+    if args.port:
+        import serial
+
+        entrada = serial.Serial(args.port, args.baud, timeout=0.1)
+    elif args.captura:
+        entrada = open(args.captura, 'rb')
+    else:
+        entrada = sys.stdin.buffer
+
+    try:
+        while True:
+            dados = entrada.read(256)
+            if not dados and not args.port:
+                break
+            for linha in decodificador.alimentar(dados):
+                sys.stdout.write(linha)
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+
+    sys.stderr.write('[log_decoder] %d registros, %d bytes no fio, %d bytes de texto (%.1fx), %d erros\n' % (
+        decodificador.registros, decodificador.bytes_recebidos, decodificador.bytes_texto,
+        decodificador.reducao(), decodificador.erros))
+
+
+if __name__ == '__main__':
+    main()
@@ -6,130 +6,650 @@
  * Descrição: Sistema multitarefa com FreeRTOS no ESP32
  * Funções: geração, recepção e supervisão de dados com WDT, fila e eventos
  * Reset do contador de timeout após reinício ou após tratamento, garantindo previsibilidade.
- * Capacidade da fila para 10 elementos, para que a Task1 não descarte dados com frequência.
+ * Capacidade da fila em FILA_CAPACIDADE (sistema_config.h), para que a Task1 não descarte dados com frequência.
+ * Transporte Task1 -> Task2 selecionável: fila FreeRTOS ou ring SPSC lock-free (transporte.c).
  * Divisão em módulos: Task1: Geração de dados // Task2: Recepção de dados // Task3: Supervisão
  * Tratamento de erros
  * Watchdog Timer funcionando (WDT)
  * Comunicação por fila e eventos
+ * Log assíncrono: as tasks enfileiram as mensagens e a task LogDreno escreve no console (log_async.c)
  * Impressões detalhadas e formatadas = {Cleber Dilenes - RM: 89056} [FILA] Dado enviado com sucesso!
 
  */
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/queue.h"
-#include "freertos/event_groups.h"
 #include "esp_system.h"
 #include "esp_task_wdt.h"
 #include "esp_chip_info.h"
+#include "esp_timer.h"
+#include "sistema_config.h"
+#include "transporte.h"
+#include "pool_blocos.h"
+#include "log_async.h"
+#include "monitor_cpu.h"
+#include "histograma.h"
+#include "periodica.h"
+#include "amostragem.h"
+#include "bloco_dados.h"
+#include "lote.h"
+#include "contrapressao.h"
+#include "sequencia.h"
+#include "heap_uso.h"
+#include "perfil_pilha.h"
+#include "recuperacao.h"
+#include "estado_rtc.h"
+#include "eventos.h"
+#include "trabalhadores.h"
+#include "faixas.h"
+#include "controle_taxa.h"
+#include "benchmarks.h"
 
 // ==========================================
 // Configuração do Watchdog Timer (WDT)
 #define WDT_TIMEOUT_MS 5000 // Tempo limite de 5 segundos para o WDT
 
 // ==========================================
-// Declaração da fila e do grupo de eventos
-QueueHandle_t fila = NULL;                // Fila para comunicação entre tasks
-EventGroupHandle_t event_supervisor = NULL; // Grupo de eventos para sinalizar o status das tasks
+// Períodos das tasks (xTaskDelayUntil: o trabalho não alonga o período)
+#define TASK1_PERIODO_MS 1000 // Fluxo de 1 Hz para os consumidores
+#define TASK3_PERIODO_MS 2000
+#define TASK4_PERIODO_MS 3000
 
-// Bits de status para o EventGroup
-#define BIT_TASK1_OK       (1 << 0)
-#define BIT_TASK1_FAIL     (1 << 1)
-#define BIT_TASK2_OK       (1 << 2)
-#define BIT_TASK2_TIMEOUT  (1 << 3)
-#define BIT_TASK2_RESET    (1 << 4)
-#define BIT_TASK2_RESTART  (1 << 5)
+// ==========================================
+// Timeouts da Task2 (tempo sem receber dados)
+// Equivalentes aos antigos 10/20/30 ciclos de polling de 500 ms
+#define TASK2_TIMEOUT_LEVE_MS      5000  // Recuperação leve
+#define TASK2_TIMEOUT_MODERADO_MS  10000 // Limpa a fila
+#define TASK2_TIMEOUT_AGRESSIVO_MS 15000 // Recria a Task1
+#define TASK2_TIMEOUT_CHIP_MS      25000 // Recriar a Task1 não resolveu: reinicia o sistema
+#define TASK2_ESPERA_MAX_MS        1000  // Bloqueio máximo por espera (menor que o WDT)
+
+// Limiar do próximo nível, indexado pelo número de níveis já aplicados
+static const int64_t task2_limiar_ms[] = {
+    TASK2_TIMEOUT_LEVE_MS, TASK2_TIMEOUT_MODERADO_MS, TASK2_TIMEOUT_AGRESSIVO_MS, TASK2_TIMEOUT_CHIP_MS
+};
+
+// ==========================================
+// Pool de blocos para os buffers de dados (substitui malloc/free no laço da Task2)
+#define POOL_AMOSTRAS_BLOCOS 4
+POOL_BLOCOS_MEMORIA(mem_amostras, sizeof(fila_item_t), POOL_AMOSTRAS_BLOCOS);
+pool_blocos_t pool_amostras;
+
+// Latência fim a fim (µs) entre o envio na Task1 e a recepção na Task2
+histograma_t latencia_fila;
+histograma_t latencia_faixa[FAIXAS]; // A mesma latência separada por faixa de prioridade
+
+#if TASK1_MODO == TASK1_MODO_AMOSTRAGEM
+static lote_t lote_task1; // Acúmulo da Task1 (lido pela Task4)
+#else
+static contrapressao_t cp_task1; // Política de fila cheia da Task1 (lida pela Task4)
+#if CONTROLE_TAXA
+static controle_taxa_t ct_task1; // Período adaptativo da Task1 (lido pela Task4)
+#endif
+#endif
+
+// Tempo de boot (esp_timer conta desde a inicialização do chip)
+static int64_t app_main_us;          // Entrada no app_main
+static int64_t tasks_criadas_us;     // Fim da criação das tasks
+static int64_t primeira_amostra_us;  // Primeiro dado recebido pela Task2 (0 = ainda não)
+static int64_t estado_restaurado_us; // Fim da restauração do estado RTC
+static bool boot_quente;             // Estado RTC válido: retomada após reset
+static uint32_t reenviados_boot;     // Itens da fila reenviados após o reset
+
+#if ALOCACAO_ESTATICA
+// Memória das tasks reservada em tempo de compilação
+static StackType_t pilha_task1[TASK1_PILHA];
+static StackType_t pilha_task2[TASK2_PILHA];
+static StackType_t pilha_task3[TASK3_PILHA];
+static StackType_t pilha_task4[TASK4_PILHA];
+static StaticTask_t tcb_task1, tcb_task2, tcb_task3, tcb_task4;
+#define MEMORIA_TASK(n) .memoria_pilha = pilha_task##n, .tcb = &tcb_task##n
+#else
+#define MEMORIA_TASK(n) .memoria_pilha = NULL, .tcb = NULL
+#endif
+
+// Tasks do sistema, recriáveis pelo gerente de recuperação
+void Task1(void *pv);
+void Task2(void *pv);
+void Task3(void *pv);
+void Task4(void *pv);
+void Produtor(void *pv);
+
+static void task1_limpar(void);
+#define TASK1_LIMPAR task1_limpar
+
+static rec_task_t tarefa_task1 = { .funcao = Task1, .nome = "Task1", .pilha = TASK1_PILHA,
+                                   .prioridade = TASK1_PRIORIDADE, .nucleo = TASK1_NUCLEO,
+                                   MEMORIA_TASK(1), .limpar = TASK1_LIMPAR };
+static rec_task_t tarefa_task2 = { .funcao = Task2, .nome = "Task2", .pilha = TASK2_PILHA,
+                                   .prioridade = TASK2_PRIORIDADE, .nucleo = TASK2_NUCLEO, MEMORIA_TASK(2) };
+static rec_task_t tarefa_task3 = { .funcao = Task3, .nome = "Task3", .pilha = TASK3_PILHA,
+                                   .prioridade = TASK3_PRIORIDADE, .nucleo = TASK3_NUCLEO, MEMORIA_TASK(3) };
+static rec_task_t tarefa_task4 = { .funcao = Task4, .nome = "Task4", .pilha = TASK4_PILHA,
+                                   .prioridade = TASK4_PRIORIDADE, .nucleo = TASK4_NUCLEO, MEMORIA_TASK(4) };
+
+#if TRABALHADORES > 0
+// Pool que processa as amostras recebidas pela Task2
+static trabalhadores_t pool_trabalho;
+#if ALOCACAO_ESTATICA
+static StackType_t pilha_trabalhadores[TRABALHADORES * TRABALHADOR_PILHA];
+static StaticTask_t tcb_trabalhadores[TRABALHADORES];
+#define MEMORIA_TRABALHADORES pilha_trabalhadores, tcb_trabalhadores
+#else
+#define MEMORIA_TRABALHADORES NULL, NULL
+#endif
+#endif
+
+#if PRODUTORES > 1
+// Produtores extras 1..PRODUTORES-1 (o produtor 0 é a Task1), índice k - 1
+typedef struct
+{
+    uint32_t enviados;
+    uint32_t descartados; // Shard cheio: o valor novo é perdido
+    uint32_t seq;         // Próxima sequência e valor: o produtor recriado continua daqui
+    int valor;
+} produtor_stats_t;
+
+static rec_task_t tarefa_produtores[PRODUTORES - 1];
+static char nomes_produtores[PRODUTORES - 1][configMAX_TASK_NAME_LEN];
+static produtor_stats_t stats_produtores[PRODUTORES - 1]; // Escritos só pelo produtor
+#if ALOCACAO_ESTATICA
+static StackType_t pilha_produtores[PRODUTORES - 1][PRODUTOR_PILHA];
+static StaticTask_t tcb_produtores[PRODUTORES - 1];
+#endif
+#endif
+
+// ==========================================
+// Converte um prazo absoluto (µs de esp_timer) em ticks de espera,
+// arredondando para cima e limitando a TASK2_ESPERA_MAX_MS para alimentar o WDT
+static TickType_t ticks_ate(int64_t prazo_us)
+{
+    int64_t restante_us = prazo_us - esp_timer_get_time();
+    const int64_t us_por_tick = 1000000LL / configTICK_RATE_HZ;
+
+    if(restante_us <= 0)
+        return 0;
+    if(restante_us > TASK2_ESPERA_MAX_MS * 1000LL)
+        restante_us = TASK2_ESPERA_MAX_MS * 1000LL;
+    return (TickType_t)((restante_us + us_por_tick - 1) / us_por_tick);
+}
+
+// ==========================================
+// Carga de estresse do perfil de pilhas: a cada PERFIL_PILHAS_CICLO_S a Task1
+// se cala por 12 s (leva a Task2 às recuperações leve e moderada) e depois a
+// Task2 pausa por 20 s (enche a fila e leva a Task1 ao caminho de fila cheia)
+#if PERFIL_PILHAS
+static bool fase_estresse(uint32_t inicio_s, uint32_t fim_s)
+{
+    uint32_t t = (uint32_t)(esp_timer_get_time() / 1000000) % PERFIL_PILHAS_CICLO_S;
+    return t >= inicio_s && t < fim_s;
+}
+#define TASK1_SILENCIO() fase_estresse(0, 12)
+#define TASK2_PAUSA()    fase_estresse(12, 32)
+#else
+#define TASK1_SILENCIO() false
+#define TASK2_PAUSA()    false
+#endif
+
+// ==========================================
+// Falha injetada na Task1 (INJETAR_FALHA): produção para FALHA_APOS_S depois
+// do início da task; a versão persistente não se desfaz com a recriação
+#if TASK1_MODO == TASK1_MODO_PERIODICO
+static bool falha_injetada(int64_t inicio_task_us)
+{
+#if INJETAR_FALHA == FALHA_NENHUMA
+    return false;
+#else
+    static bool persistente = false;
+    if(esp_timer_get_time() - inicio_task_us < FALHA_APOS_S * 1000000LL && !persistente)
+        return false;
+    persistente = INJETAR_FALHA == FALHA_TASK1_PERSISTENTE;
+    return true;
+#endif
+}
+#endif
+
+// ==========================================
+// Faixa de um valor produzido: um em FAIXA_ALARME_CADA simula um alarme, que
+// não pode esperar atrás dos valores de volume
+#if TASK1_MODO == TASK1_MODO_PERIODICO || PRODUTORES > 1
+static uint16_t faixa_do_valor(int valor)
+{
+    if(FAIXAS > 1 && FAIXA_ALARME_CADA > 0 && valor % FAIXA_ALARME_CADA == 0)
+        return FAIXA_URGENTE;
+    return FAIXA_VOLUME;
+}
+#endif
+
+// ==========================================
+// Controle de taxa da Task1: observa a faixa de volume, que é a que enche (a
+// urgente é atendida antes), e a vazão entregue pelo consumidor em todas as faixas
+#if TASK1_MODO == TASK1_MODO_PERIODICO && CONTROLE_TAXA
+static void controlar_taxa(periodica_t *ctl)
+{
+    uint32_t atendidos[FAIXAS], ocupacao[FAIXAS];
+    uint32_t consumidos = 0;
+
+    transporte_faixas(atendidos, ocupacao);
+    for(uint32_t f = 0; f < FAIXAS; f++)
+        consumidos += atendidos[f];
+
+    periodica_ajustar(ctl, controle_taxa_atualizar(&ct_task1, ocupacao[FAIXA_VOLUME], consumidos,
+                                                   esp_timer_get_time()));
+}
+#endif
+
+// ==========================================
+// Transporte sem cópia: o quadro é preenchido e processado no próprio bloco
+#if FILA_ZERO_COPIA
+static void preencher_quadro(bloco_dados_t *bloco, int valor)
+{
+    memset(bloco->dados, (uint8_t)valor, BLOCO_PAYLOAD); // Simula a leitura de um sensor
+    bloco->tamanho = BLOCO_PAYLOAD;
+}
+
+static uint32_t processar_quadro(const bloco_dados_t *bloco)
+{
+    uint32_t soma = 0;
+    for(uint32_t i = 0; i < bloco->tamanho; i++)
+        soma += bloco->dados[i];
+    return soma;
+}
+#endif
+
+// Processamento de uma amostra: o quadro (sem cópia) e a carga TRABALHO_CICLOS.
+// Roda na Task2 ou, com TRABALHADORES > 0, em um trabalhador do pool.
+static void processar_amostra(const fila_item_t *item)
+{
+#if FILA_ZERO_COPIA
+    if(item->bloco != NULL)
+    {
+        processar_quadro(item->bloco); // Processa no lugar, sem copiar o quadro
+        bloco_dados_liberar(item->bloco);
+    }
+#endif
+    if(TRABALHO_CICLOS > 0)
+        trabalho_carga(TRABALHO_CICLOS);
+}
+
+// Recuperação moderada: esvazia a fila devolvendo ao pool os blocos que estavam nela
+static void descartar_fila(void)
+{
+#if FILA_ZERO_COPIA
+    fila_item_t item;
+    while(transporte_receber(&item, 0))
+        bloco_dados_liberar(item.bloco);
+#endif
+    transporte_reset();
+}
+
+// ==========================================
+// Task1 no modo de amostragem: a ISR do gptimer gera as amostras e a Task1
+// as acumula (lote.c) e repassa em lotes de até LOTE_N para a fila
+#if TASK1_MODO == TASK1_MODO_AMOSTRAGEM
+static void Task1_amostragem(void)
+{
+    static fila_item_t leitura[AMOSTRAGEM_LOTE];
+    int64_t proximo_relatorio_us = esp_timer_get_time() + 1000000;
+
+    lote_init(&lote_task1, LOTE_N, LOTE_T_US);
+    if(!amostragem_iniciar(AMOSTRAGEM_FREQ_HZ, xTaskGetCurrentTaskHandle()))
+    {
+        log_printf("{Cleber Dilenes - RM:89056} [ERROR] Falha ao iniciar o timer de amostragem\n");
+        vTaskDelete(NULL);
+    }
+
+    while(1)
+    {
+        recuperacao_ponto_parada(); // Pedido do gerente de recuperação: encerra aqui
+
+        // Acorda com um lote da ISR ou no prazo do lote acumulado
+        ulTaskNotifyTake(pdTRUE, ticks_ate(lote_prazo_us(&lote_task1)));
+
+        uint32_t n, descartados = 0, descargas = lote_task1.descargas_tamanho + lote_task1.descargas_tempo;
+        while((n = amostragem_ler_lote(leitura, AMOSTRAGEM_LOTE)) > 0)
+        {
+            for(uint32_t i = 0; i < n; i++)
+                descartados += lote_adicionar(&lote_task1, &leitura[i]);
+        }
+        descartados += lote_verificar_prazo(&lote_task1);
+
+        // Um aviso ao supervisor por descarga, não por amostra
+        if(descartados > 0)
+            evento_sinalizar(EVT_TASK1_FALHA); // Fila cheia: excedente descartado
+        else if(lote_task1.descargas_tamanho + lote_task1.descargas_tempo != descargas)
+            evento_sinalizar(EVT_TASK1_OK);
+
+        if(esp_timer_get_time() >= proximo_relatorio_us)
+        {
+            amostragem_stats_t st;
+            amostragem_estatisticas(&st);
+            log_printf("{Cleber Dilenes - RM:89056} [AMOSTRAGEM] %lu Hz: %lu amostras, %lu perdidas na ISR, %lu na fila\n",
+                       st.freq_hz, st.geradas, st.descartadas, lote_task1.descartados);
+            proximo_relatorio_us += 1000000;
+        }
+
+        esp_task_wdt_reset(); // Reseta o WDT
+    }
+}
+#endif
+
+#if TASK1_MODO == TASK1_MODO_PERIODICO && FILA_ZERO_COPIA
+// Bloco alocado pela Task1 e ainda não entregue (devolvido se ela for removida à força)
+static bloco_dados_t *bloco_em_maos;
+#endif
+
+// Recursos da Task1 removida, antes de recriá-la (roda na Task2)
+static void task1_limpar(void)
+{
+#if TASK1_MODO == TASK1_MODO_AMOSTRAGEM
+    amostragem_parar(); // Libera o gptimer
+#elif FILA_ZERO_COPIA
+    bloco_dados_liberar(bloco_em_maos); // NULL: nada em mãos
+    bloco_em_maos = NULL;
+#endif
+    transporte_produtor_removido(ORIGEM_TASK1);
+}
 
 // ==========================================
 // Task1: Geração de dados
 void Task1(void *pv)
 {
-    int value = 0; // Valor inteiro crescente
+#if TASK1_MODO == TASK1_MODO_AMOSTRAGEM
+    esp_task_wdt_add(NULL);
+    Task1_amostragem(); // Não retorna
+#else
+    // Estáticos: valor, sequência e retidos continuam quando a task é recriada
+    static int value = 0; // Valor inteiro crescente
+    static uint32_t seq = 0; // Sequência dos registros enviados (inclui os descartados)
+    static periodica_t ctl;
+    static bool iniciada = false;
+    int64_t inicio_us = esp_timer_get_time();
+
+    periodica_init(&ctl, "Task1", TASK1_PERIODO_MS);
+    if(!iniciada)
+    {
+        contrapressao_init(&cp_task1, CONTRAPRESSAO_POLITICA, transporte_enviar);
+#if CONTROLE_TAXA
+        controle_taxa_init(&ct_task1, CONTROLE_PERIODO_MIN_MS, TASK1_PERIODO_MS,
+                           PRODUTORES * FILA_CAPACIDADE, CONTROLE_OCUPACAO_ALVO_PCT);
+#endif
+        estado_rtc_produtor(&value, &seq); // Continua de onde parou antes de um reset
+    }
+    iniciada = true;
 
     esp_task_wdt_add(NULL); // Adiciona esta task ao WDT
 
     while(1)
     {
-        // Tenta enviar o valor para a fila sem bloqueio
-        if(xQueueSend(fila, &value, 0) != pdTRUE)
+        recuperacao_ponto_parada(); // Pedido do gerente de recuperação: encerra aqui
+
+        periodica_inicio(&ctl);
+#if CONTROLE_TAXA
+        controlar_taxa(&ctl); // Próximo período conforme a ocupação e a vazão do consumidor
+#endif
+        if(TASK1_SILENCIO() || falha_injetada(inicio_us))
+        {
+            esp_task_wdt_reset();
+            periodica_aguardar(&ctl);
+            continue;
+        }
+
+        // Envia o valor; com a fila cheia vale a política de contrapressão
+        fila_item_t item = {
+            .seq = seq++,
+            .t_producao = (uint32_t)esp_timer_get_time(),
+            .valor = value,
+            .origem = ORIGEM_TASK1,
+            .faixa = faixa_do_valor(value),
+        };
+#if FILA_ZERO_COPIA
+        item.bloco = bloco_dados_alocar(); // NULL se o pool esgotar: envia só o valor
+        bloco_em_maos = item.bloco;
+        if(item.bloco != NULL)
+            preencher_quadro(item.bloco, value);
+        bloco_em_maos = NULL; // A posse passa para o transporte (ou volta ao pool pela política)
+#endif
+        uint32_t perdidos = contrapressao_enviar(&cp_task1, &item); // Blocos perdidos voltam ao pool
+        if(perdidos > 0)
         {
-            // Fila cheia, valor descartado
-            printf("{Cleber Dilenes - RM: 89056} [FILA CHEIA] Não foi possível enviar valor %d\n", value);
-            xEventGroupSetBits(event_supervisor, BIT_TASK1_FAIL); // Sinaliza falha
+            // Fila cheia, valor descartado (o novo ou um retido, conforme a política)
+            log_printf("{Cleber Dilenes - RM: 89056} [FILA CHEIA] Política %s descartou %lu valor(es) (atual %d)\n",
+                       contrapressao_nome(cp_task1.politica), perdidos, value);
+            evento_sinalizar(EVT_TASK1_FALHA); // Sinaliza falha
+        }
+        else if(cp_task1.n > 0)
+        {
+            // Fila cheia, valor guardado na reserva da política
+            log_printf("{Cleber Dilenes - RM:89056} [FILA CHEIA] Valor %d retido (%s, %lu pendentes)\n",
+                       value, contrapressao_nome(cp_task1.politica), cp_task1.n);
+            evento_sinalizar(EVT_TASK1_OK);
         }
         else
         {
             // Valor enviado com sucesso
-            printf("{Cleber Dilenes - RM:89056} [FILA OK] Valor %d enviado para a fila\n", value);
-            xEventGroupSetBits(event_supervisor, BIT_TASK1_OK); // Sinaliza sucesso
+            log_printf("{Cleber Dilenes - RM:89056} [FILA OK] Valor %d enviado para a fila\n", value);
+            evento_sinalizar(EVT_TASK1_OK); // Sinaliza sucesso
         }
 
         value++; // Incrementa o valor
+        estado_rtc_salvar_produtor(value, seq); // Sobrevive a um reset do chip
         esp_task_wdt_reset(); // Reseta o WDT
-        vTaskDelay(pdMS_TO_TICKS(1000)); // Aguarda 1 segundo
+        periodica_aguardar(&ctl); // Aguarda o próximo período exato
+    }
+#endif
+}
+
+#if PRODUTORES > 1
+// ==========================================
+// Produtor extra k: mesmo período da Task1, origem e sequência próprias, no
+// seu shard. Sem reserva de contrapressão nem log por amostra.
+void Produtor(void *pv)
+{
+    uint32_t k = (uint32_t)(uintptr_t)pv;
+    produtor_stats_t *stats = &stats_produtores[k - 1];
+    TickType_t despertar = xTaskGetTickCount();
+
+    esp_task_wdt_add(NULL); // Adiciona esta task ao WDT
+
+    while(1)
+    {
+        recuperacao_ponto_parada(); // Pedido do gerente de recuperação: encerra aqui
+
+        fila_item_t item = {
+            .seq = stats->seq++,
+            .t_producao = (uint32_t)esp_timer_get_time(),
+            .valor = stats->valor,
+            .origem = ORIGEM_PRODUTOR(k),
+            .faixa = faixa_do_valor(stats->valor),
+        };
+        stats->valor++;
+        if(transporte_enviar(&item))
+        {
+            stats->enviados++;
+            evento_sinalizar(EVT_PRODUTOR_OK);
+        }
+        else
+        {
+            stats->descartados++;
+            evento_sinalizar(EVT_PRODUTOR_FALHA);
+        }
+
+        esp_task_wdt_reset();
+        xTaskDelayUntil(&despertar, pdMS_TO_TICKS(TASK1_PERIODO_MS));
+    }
+}
+
+// Cria o produtor extra k, alternando os núcleos a partir do núcleo 1
+static bool criar_produtor(uint32_t k)
+{
+    rec_task_t *t = &tarefa_produtores[k - 1];
+
+    snprintf(nomes_produtores[k - 1], sizeof(nomes_produtores[0]), "Prod%lu", k);
+    *t = (rec_task_t){
+        .funcao = Produtor,
+        .parametro = (void *)(uintptr_t)k,
+        .nome = nomes_produtores[k - 1],
+        .pilha = PRODUTOR_PILHA,
+        .prioridade = TASK1_PRIORIDADE,
+        .nucleo = k % portNUM_PROCESSORS,
+#if ALOCACAO_ESTATICA
+        .memoria_pilha = pilha_produtores[k - 1],
+        .tcb = &tcb_produtores[k - 1],
+#endif
+    };
+    return recuperacao_criar_task(t);
+}
+#endif
+
+// ==========================================
+// Recuperação por produtor: cada shard tem seu próprio tempo sem dados, para
+// que os produtores extras não escondam uma Task1 parada
+static rec_task_t *tarefa_do_produtor(uint32_t p)
+{
+#if PRODUTORES > 1
+    if(p > 0)
+        return &tarefa_produtores[p - 1];
+#endif
+    return &tarefa_task1;
+}
+
+// Aplica ao produtor p o próximo nível de recuperação. Retorna os níveis já aplicados.
+static int recuperar_produtor(uint32_t p, int nivel)
+{
+    rec_task_t *t = tarefa_do_produtor(p);
+
+    if(nivel == 0)
+    {
+        // Primeiro nível de falha (leve)
+        log_printf("{Cleber Dilenes - RM:89056} [TIMEOUT] Recuperação leve - Espera (%s)\n", t->nome);
+        evento_sinalizar(EVT_TASK2_TIMEOUT);
+        recuperacao_aplicada(REC_LEVE);
+        return 1;
+    }
+    if(nivel == 1)
+    {
+        // Segundo nível (reset da fila, compartilhada por todos os produtores)
+        log_printf("{Cleber Dilenes - RM:89056} [TIMEOUT] Recuperação moderada - Limpa fila (%s)\n", t->nome);
+        descartar_fila(); // Limpa a fila
+        evento_sinalizar(EVT_TASK2_RESET);
+        recuperacao_aplicada(REC_MODERADA);
+        return 2;
+    }
+    if(nivel == 2)
+    {
+        // Terceiro nível: recria só o produtor sem dados, mantendo as demais tasks
+        log_printf("{Cleber Dilenes - RM:89056} [TIMEOUT] Recuperação agressiva - Recria a %s\n", t->nome);
+        recuperacao_aplicada(REC_TASK);
+        bool recriada = recuperacao_reiniciar_task(t);
+        descartar_fila(); // Começa o novo produtor com a fila vazia
+        if(p == 0)
+            evento_sinalizar(EVT_TASK1_RECRIADA);
+        return recriada ? 3 : 4; // Se a recriação falhou, vai direto ao reset do chip
     }
+
+    // Último nível: a recuperação por task não resolveu, reinicia o sistema
+    log_printf("{Cleber Dilenes - RM:89056} [TIMEOUT] Recuperação agressiva - Reiniciar o sistema (%s)\n", t->nome);
+    evento_sinalizar(EVT_TASK2_RESTART);
+    recuperacao_aplicada(REC_CHIP);
+    vTaskDelay(pdMS_TO_TICKS(100)); // Espera um pouco
+    esp_restart(); // Reinicia o ESP32
+    return nivel;
 }
 
 // ==========================================
 // Task2: Recepção de dados
 void Task2(void *pv)
 {
-    int timeout = 0; // Contador para detectar falhas
+    int64_t ultimo_dado_us[PRODUTORES]; // Instante do último dado de cada produtor
+    int nivel[PRODUTORES];              // Níveis de recuperação aplicados desde esse dado
+    static periodica_t ctl;
+    periodica_init(&ctl, "Task2", 0); // Orientada a eventos: mede apenas o tempo de processamento
+
+    for(uint32_t p = 0; p < PRODUTORES; p++)
+    {
+        ultimo_dado_us[p] = esp_timer_get_time();
+        nivel[p] = 0;
+    }
 
     esp_task_wdt_add(NULL); // Adiciona a task ao WDT
 
     while(1)
     {
-        int *ptr = malloc(sizeof(int)); // Aloca memória dinamicamente
+        if(TASK2_PAUSA())
+        {
+            vTaskDelay(pdMS_TO_TICKS(500));
+            esp_task_wdt_reset();
+            for(uint32_t p = 0; p < PRODUTORES; p++)
+                ultimo_dado_us[p] = esp_timer_get_time(); // A pausa não conta como falta de dados
+            continue;
+        }
+
+        fila_item_t *ptr = pool_blocos_alocar(&pool_amostras); // Bloco do pool (O(1), sem heap)
         if(ptr == NULL)
         {
-            // Falha na alocação
-            printf("{Cleber Dilenes - RM:89056} [ERROR] Falha ao alocar memória\n");
+            // Pool esgotado
+            log_printf("{Cleber Dilenes - RM:89056} [ERROR] Falha ao alocar memória do pool\n");
             vTaskDelay(pdMS_TO_TICKS(500));
             continue;
         }
 
-        // Tenta receber um dado da fila
-        if(xQueueReceive(fila, ptr, 0) == pdTRUE)
+        // Bloqueia na fila até chegar um dado ou até o limiar mais próximo entre os produtores
+        int64_t prazo_us = INT64_MAX;
+        for(uint32_t p = 0; p < PRODUTORES; p++)
         {
-            timeout = 0; // Reseta contador de falhas
-            printf("{Cleber Dilenes - RM:89056} [FILA OK] Recebeu valor %d\n", *ptr);
-            xEventGroupSetBits(event_supervisor, BIT_TASK2_OK); // Sinaliza sucesso
+            int64_t limiar_us = nivel[p] < 4 ? ultimo_dado_us[p] + task2_limiar_ms[nivel[p]] * 1000LL : 0;
+            if(limiar_us < prazo_us)
+                prazo_us = limiar_us;
         }
-        else
+        if(transporte_receber(ptr, ticks_ate(prazo_us)))
         {
-            timeout++; // Incrementa falha consecutiva
+            periodica_inicio(&ctl);
+            int64_t agora_us = esp_timer_get_time();
+            uint32_t produtor = transporte_shard(ptr->origem);
+            uint32_t latencia_us = (uint32_t)agora_us - ptr->t_producao;
+            histograma_registrar(&latencia_fila, latencia_us);
+            histograma_registrar(&latencia_faixa[ptr->faixa < FAIXAS ? ptr->faixa : FAIXAS - 1], latencia_us);
+            if(primeira_amostra_us == 0)
+                primeira_amostra_us = agora_us;
+            ultimo_dado_us[produtor] = agora_us;
+            if(nivel[produtor] > 0)
+                recuperacao_dados_ok(); // Fecha o incidente (MTTR do último nível aplicado)
+            nivel[produtor] = 0; // Reseta contador de falhas
+            if(LOG_POR_AMOSTRA)
+                log_printf("{Cleber Dilenes - RM:89056} [FILA OK] Recebeu valor %d\n", ptr->valor);
 
-            if(timeout == 10)
-            {
-                // Primeiro nível de falha (leve)
-                printf("{Cleber Dilenes - RM:89056} [TIMEOUT] Recuperação leve - Espera\n");
-                xEventGroupSetBits(event_supervisor, BIT_TASK2_TIMEOUT);
-            }
-            else if(timeout == 20)
-            {
-                // Segundo nível (reset da fila)
-                printf("{Cleber Dilenes - RM:89056} [TIMEOUT] Recuperação moderada - Limpa fila\n");
-                xQueueReset(fila); // Limpa a fila
-                xEventGroupSetBits(event_supervisor, BIT_TASK2_RESET);
-                timeout = 0; // Reinicia o contador
-            }
-            else if(timeout == 30)
-            {
-                // Terceiro nível: reinicia o sistema
-                printf("{Cleber Dilenes - RM:89056} [TIMEOUT] Recuperação agressiva - Reiniciar o sistema\n");
-                xEventGroupSetBits(event_supervisor, BIT_TASK2_RESTART);
-                free(ptr);
-                vTaskDelay(pdMS_TO_TICKS(100)); // Espera um pouco
-                esp_restart(); // Reinicia o ESP32
-            }
+            // Lacunas/duplicatas/reordenação: perdas na fila ou na recuperação ficam visíveis
+            seq_evento_t ev = sequencia_registrar(ptr->origem, ptr->seq);
+            if(LOG_POR_AMOSTRA && ev != SEQ_OK)
+                log_printf("{Cleber Dilenes - RM:89056} [SEQUENCIA] %s: origem %u, seq %lu\n",
+                           sequencia_nome(ev), ptr->origem, ptr->seq);
+#if TRABALHADORES > 0
+            if(!trabalhadores_enviar(&pool_trabalho, ptr))
+                processar_amostra(ptr); // Deques cheios: a Task2 processa, sem perder a amostra
+#else
+            processar_amostra(ptr);
+#endif
+            evento_sinalizar(EVT_TASK2_OK); // Sinaliza sucesso
+            periodica_fim(&ctl);
+        }
+
+        pool_blocos_liberar(&pool_amostras, ptr); // Devolve o bloco ao pool
+
+        // Escala a recuperação de cada produtor sem dados além do seu limiar,
+        // mesmo que os outros continuem entregando
+        int64_t agora_us = esp_timer_get_time();
+        for(uint32_t p = 0; p < PRODUTORES; p++)
+        {
+            if(nivel[p] == 4 || agora_us - ultimo_dado_us[p] >= task2_limiar_ms[nivel[p]] * 1000LL)
+                nivel[p] = recuperar_produtor(p, nivel[p]);
         }
 
-        free(ptr); // Libera a memória
         esp_task_wdt_reset(); // Reseta o WDT
-        vTaskDelay(pdMS_TO_TICKS(500)); // Aguarda meio segundo
     }
 }
 
@@ -137,64 +657,188 @@ void Task2(void *pv)
 // Task3: Supervisão
 void Task3(void *pv)
 {
+    static periodica_t ctl;
+    periodica_init(&ctl, "Task3", TASK3_PERIODO_MS);
+
+    // Recriada ou não, parte da contagem atual: só reporta eventos novos
+    uint32_t anterior[EVT_NUM];
+    int64_t anterior_us = esp_timer_get_time();
+    eventos_ler(anterior);
+
     esp_task_wdt_add(NULL); // Adiciona esta task ao WDT
 
     while(1)
     {
-        // Aguarda qualquer evento disparado pelas outras tasks
-        EventBits_t bits = xEventGroupWaitBits(
-            event_supervisor,
-            BIT_TASK1_OK | BIT_TASK1_FAIL |
-            BIT_TASK2_OK | BIT_TASK2_TIMEOUT | BIT_TASK2_RESET | BIT_TASK2_RESTART,
-            pdTRUE,  // Limpa os bits após leitura
-            pdFALSE, // Qualquer bit é suficiente
-            pdMS_TO_TICKS(0)
-        );
-
-        // Verifica e exibe os eventos recebidos
-        if(bits & BIT_TASK1_OK)
-            printf("{Cleber Dilenes - RM:89056} [SUPERVISOR] Task1 OK\n");
-        if(bits & BIT_TASK1_FAIL)
-            printf("{Cleber Dilenes - RM:89056} [SUPERVISOR] Task1 falhou no envio\n");
-        if(bits & BIT_TASK2_OK)
-            printf("{Cleber Dilenes - RM:89056} [SUPERVISOR] Task2 OK\n");
-        if(bits & BIT_TASK2_TIMEOUT)
-            printf("{Cleber Dilenes - RM:89056} [SUPERVISOR] Task2 em timeout leve\n");
-        if(bits & BIT_TASK2_RESET)
-            printf("{Cleber Dilenes - RM:89056} [SUPERVISOR] Task2 resetou a fila\n");
-        if(bits & BIT_TASK2_RESTART)
-            printf("{Cleber Dilenes - RM:89056} [SUPERVISOR] Task2 reiniciou o sistema\n");
+        periodica_inicio(&ctl);
+
+        // Diferença dos contadores desde a última ativação: nenhum evento se perde
+        uint32_t agora[EVT_NUM];
+        int64_t agora_us = esp_timer_get_time();
+        eventos_ler(agora);
+        uint32_t janela_ms = (uint32_t)((agora_us - anterior_us) / 1000);
+        if(janela_ms == 0)
+            janela_ms = 1;
+
+        uint32_t delta[EVT_NUM];
+        for(int ev = 0; ev < EVT_NUM; ev++)
+        {
+            delta[ev] = agora[ev] - anterior[ev];
+            if(delta[ev] > 0)
+            {
+                uint32_t taxa = (uint32_t)((uint64_t)delta[ev] * 10000 / janela_ms); // Décimos de evento/s
+                log_printf("{Cleber Dilenes - RM:89056} [SUPERVISOR] %s: %lu (%lu.%lu/s)\n",
+                           evento_nome(ev), delta[ev], taxa / 10, taxa % 10);
+            }
+            anterior[ev] = agora[ev];
+        }
+        anterior_us = agora_us;
+
+        // Razões de erro na janela (permil): envios perdidos e esperas sem dados
+        uint32_t falhas_envio = delta[EVT_TASK1_FALHA] + delta[EVT_PRODUTOR_FALHA];
+        uint32_t envios = delta[EVT_TASK1_OK] + delta[EVT_PRODUTOR_OK] + falhas_envio;
+        uint32_t esperas = delta[EVT_TASK2_OK] + delta[EVT_TASK2_TIMEOUT];
+        if(envios > 0 || esperas > 0)
+        {
+            uint32_t erro_envio = envios ? (uint32_t)((uint64_t)falhas_envio * 1000 / envios) : 0;
+            uint32_t erro_espera = esperas ? (uint32_t)((uint64_t)delta[EVT_TASK2_TIMEOUT] * 1000 / esperas) : 0;
+            log_printf("{Cleber Dilenes - RM:89056} [SUPERVISOR] Erros: envio %lu.%lu%%  timeout %lu.%lu%%\n",
+                       erro_envio / 10, erro_envio % 10, erro_espera / 10, erro_espera % 10);
+        }
 
         esp_task_wdt_reset(); // Reseta o WDT
-        vTaskDelay(pdMS_TO_TICKS(2000)); // Aguarda 2 segundos
+        periodica_aguardar(&ctl); // Aguarda 2 segundos desde a última ativação
     }
 }
 
 // ==========================================
-// Task4: Logger do sistema (informações do chip)
+// Task4: Logger do sistema (informações do chip e uso de CPU por task)
 void Task4(void *pv)
 {
+    static periodica_t ctl;
+    periodica_init(&ctl, "Task4", TASK4_PERIODO_MS);
+
     esp_task_wdt_add(NULL); // Adiciona esta task ao WDT
 
     while(1)
     {
+        periodica_inicio(&ctl);
+
         esp_chip_info_t chip_info;
         esp_chip_info(&chip_info); // Obtém informações do chip
 
         // Imprime informações de status
-        printf("{Cleber Dilenes - RM:89056} [LOGGER] Estado do sistema:\n");
-        printf("   - Cores: %d, Revisão: %d\n", chip_info.cores, chip_info.revision);
-        printf("   - Heap livre: %ld bytes\n", esp_get_free_heap_size());
+        log_printf("{Cleber Dilenes - RM:89056} [LOGGER] Estado do sistema:\n");
+        log_printf("   - Cores: %d, Revisão: %d\n", chip_info.cores, chip_info.revision);
+        log_printf("   - Heap livre: %ld bytes\n", esp_get_free_heap_size());
+
+        // Alocações no heap desde o relatório anterior (0 no regime permanente)
+        static heap_uso_contagem_t heap_anterior;
+        heap_uso_contagem_t heap;
+        heap_uso_contagem(&heap);
+        log_printf("   - [HEAP] Alocações no ciclo: %lu (total %lu, liberações %lu)\n",
+                   heap.alocacoes - heap_anterior.alocacoes, heap.alocacoes, heap.liberacoes);
+        heap_anterior = heap;
+        heap_uso_relatorio(); // Regiões por capacidade, fragmentação e tendência do maior bloco
+
+        log_printf("   - Boot (%s, %s #%lu): app_main em %lld us, estado restaurado em %lld us (%lu reenviados)\n",
+                   ALOCACAO_ESTATICA ? "estático" : "heap", boot_quente ? "quente" : "frio",
+                   estado_rtc_reinicios(), app_main_us, estado_restaurado_us, reenviados_boot);
+        log_printf("   - Boot: tasks criadas em %lld us, primeira amostra em %lld us\n",
+                   tasks_criadas_us, primeira_amostra_us);
+
+        pool_blocos_stats_t pool;
+        pool_blocos_estatisticas(&pool_amostras, &pool);
+        log_printf("   - Pool amostras: %lu/%lu em uso, pico %lu, falhas %lu\n",
+                   pool.em_uso, pool.num_blocos, pool.pico, pool.falhas);
+
+        log_async_stats_t log;
+        log_async_estatisticas(&log);
+        log_printf("   - Log: %lu enviadas, %lu escritas, %lu descartadas\n",
+                   log.enviadas, log.escritas, log.descartadas);
+
+#if FILA_ZERO_COPIA
+        bloco_dados_stats_t blocos;
+        bloco_dados_estatisticas(&blocos);
+        log_printf("   - Blocos de dados: %lu/%lu em uso, pico %lu, falhas %lu, vazados %lu, liberações duplas %lu\n",
+                   blocos.pool.em_uso, blocos.pool.num_blocos, blocos.pool.pico, blocos.pool.falhas,
+                   blocos.vazamentos, blocos.liberacoes_duplas);
+#endif
+
+        sequencia_relatorio(); // Taxa de perda por sequência
+
+        histograma_resumo_t lat;
+        histograma_resumo(&latencia_fila, &lat);
+        log_printf("   - Latência fila: n=%lu p50 %lu us, p99 %lu us, p99.9 %lu us, máx %lu us\n",
+                   lat.total, lat.p50, lat.p99, lat.p999, lat.maximo);
+#if FILA_TRANSPORTE == FILA_TRANSPORTE_NOTIFICACAO
+        uint32_t diretas, reserva;
+        transporte_entregas(&diretas, &reserva);
+        uint32_t diretas_permil = diretas + reserva > 0 ? (uint32_t)((uint64_t)diretas * 1000 / (diretas + reserva)) : 0;
+        log_printf("   - Notificação direta: %lu diretas, %lu pela fila de reserva (%lu.%lu%% diretas)\n",
+                   diretas, reserva, diretas_permil / 10, diretas_permil % 10);
+#endif
+#if FAIXAS > 1
+        uint32_t atendidos[FAIXAS], ocupacao[FAIXAS];
+        transporte_faixas(atendidos, ocupacao);
+        for(uint32_t f = FAIXAS; f-- > 0; )
+        {
+            histograma_resumo(&latencia_faixa[f], &lat);
+            log_printf("   - Faixa %-7s (%s): %lu atendidos, %lu na fila, p50 %lu us, p99 %lu us, máx %lu us\n",
+                       faixas_nome(f), faixas_politica_nome(FAIXAS_ESCALONAMENTO), atendidos[f], ocupacao[f],
+                       lat.p50, lat.p99, lat.maximo);
+        }
+#endif
+#if TASK1_MODO == TASK1_MODO_AMOSTRAGEM
+        lote_relatorio(&lote_task1); // Descargas por tamanho/tempo e espera no lote
+#else
+        contrapressao_relatorio(&cp_task1); // Perdas e tempo bloqueado da política
+#if CONTROLE_TAXA
+        controle_taxa_relatorio(&ct_task1); // Período atual, ocupação, vazão e decisões
+#endif
+#endif
+#if PRODUTORES > 1
+        uint32_t prod_enviados = 0, prod_descartados = 0;
+        for(uint32_t k = 0; k < PRODUTORES - 1; k++)
+        {
+            prod_enviados += stats_produtores[k].enviados;
+            prod_descartados += stats_produtores[k].descartados;
+        }
+        log_printf("   - Produtores extras: %d, %lu enviados, %lu descartados, mescla %s, fila %lu\n",
+                   PRODUTORES - 1, prod_enviados, prod_descartados,
+                   FILA_TRANSPORTE == FILA_TRANSPORTE_QUEUE ? "QueueSet" :
+                   FILA_TRANSPORTE == FILA_TRANSPORTE_RING && FILA_MESCLA == FILA_MESCLA_TEMPO ? "tempo" : "rodízio",
+                   transporte_ocupacao());
+#endif
+
+#if TRABALHADORES > 0
+        trabalhadores_relatorio(&pool_trabalho); // Processados, roubos e uso por trabalhador
+#endif
+
+        monitor_cpu_relatorio(); // CPU por task, ociosidade por núcleo, pilhas e estados
+        periodica_relatorio();   // Jitter, atrasos, WCET e deriva de cada task
+        recuperacao_relatorio(); // Ações e MTTR por nível de recuperação
+
+#if PERFIL_PILHAS
+        static int64_t proximo_perfil_us = PERFIL_PILHAS_DURACAO_S * 1000000LL;
+        if(esp_timer_get_time() >= proximo_perfil_us)
+        {
+            perfil_pilha_emitir(); // Tamanhos recomendados após os ciclos de estresse
+            proximo_perfil_us += PERFIL_PILHAS_DURACAO_S * 1000000LL;
+        }
+#endif
 
         esp_task_wdt_reset(); // Reseta o WDT
-        vTaskDelay(pdMS_TO_TICKS(3000)); // Aguarda 3 segundos
+        periodica_aguardar(&ctl); // Aguarda 3 segundos desde a última ativação
     }
 }
 
 // ==========================================
 // Função principal (app_main)
+// ==========================================
 void app_main(void)
 {
+    app_main_us = esp_timer_get_time();
+
     // Configuração do Watchdog Timer global
     esp_task_wdt_config_t wdt_config = {
         .timeout_ms = WDT_TIMEOUT_MS,            // Tempo de timeout (5s)
@@ -203,20 +847,77 @@ void app_main(void)
     };
     esp_task_wdt_init(&wdt_config); // Inicializa o WDT
 
-    // Criação da fila (10 posições) e EventGroup
-    fila = xQueueCreate(10, sizeof(int));
-    event_supervisor = xEventGroupCreate();
+#if EXECUTAR_BENCHMARKS
+    benchmarks_executar(); // Mede o transporte antes de iniciar o sistema
+#endif
 
-    // Verifica falha na criação de fila ou grupo de eventos
-    if(fila == NULL || event_supervisor == NULL)
+    // Log assíncrono: as tasks nunca escrevem direto na UART
+    if(!log_async_init())
     {
-        printf("{Cleber Dilenes - RM:89056} [ERROR] Falha na criação da fila ou EventGroup\n");
+        printf("{Cleber Dilenes - RM:89056} [ERROR] Falha na criação da task de log\n");
+        esp_restart();
+    }
+
+    // Criação da fila (FILA_CAPACIDADE posições) e dos pools
+    bool fila_ok = transporte_init() &&
+#if FILA_ZERO_COPIA
+                   bloco_dados_init() &&
+#endif
+                   pool_blocos_init(&pool_amostras, "amostras", mem_amostras,
+                                    sizeof(fila_item_t), POOL_AMOSTRAS_BLOCOS);
+    histograma_init(&latencia_fila);
+    for(uint32_t f = 0; f < FAIXAS; f++)
+        histograma_init(&latencia_faixa[f]);
+    sequencia_init();
+
+    // Boot quente: restaura recuperação e produtor e reenvia a fila salva no reset
+    boot_quente = estado_rtc_init();
+    if(fila_ok)
+        reenviados_boot = estado_rtc_reenviar();
+    estado_restaurado_us = esp_timer_get_time();
+
+    // Verifica falha na criação da fila ou dos pools
+    if(!fila_ok)
+    {
+        printf("{Cleber Dilenes - RM:89056} [ERROR] Falha na criação da fila\n");
         esp_restart(); // Reinicia o sistema se falhar
     }
 
-    // Criação das tarefas do sistema
-    xTaskCreate(Task1, "Task1", 8192, NULL, 5, NULL);
-    xTaskCreate(Task2, "Task2", 8192, NULL, 5, NULL);
-    xTaskCreate(Task3, "Task3", 8192, NULL, 5, NULL);
-    xTaskCreate(Task4, "Task4", 8192, NULL, 5, NULL);
+    // Criação das tarefas do sistema (núcleo e prioridade conforme PERFIL_AFINIDADE);
+    // os trabalhadores vêm antes da Task2, que os alimenta
+    recuperacao_init();
+    bool tasks_ok =
+#if TRABALHADORES > 0
+                    trabalhadores_iniciar(&pool_trabalho, TRABALHADORES, processar_amostra,
+                                          TASK2_PRIORIDADE, MEMORIA_TRABALHADORES) &&
+#endif
+                    recuperacao_criar_task(&tarefa_task1) &&
+                    recuperacao_criar_task(&tarefa_task2) &&
+                    recuperacao_criar_task(&tarefa_task3) &&
+                    recuperacao_criar_task(&tarefa_task4);
+#if PRODUTORES > 1
+    for(uint32_t k = 1; k < PRODUTORES && tasks_ok; k++)
+        tasks_ok = criar_produtor(k);
+#endif
+    tasks_criadas_us = esp_timer_get_time();
+
+#if PERFIL_PILHAS
+    perfil_pilha_registrar("Task1", "TASK1_PILHA", TASK1_PILHA);
+    perfil_pilha_registrar("Task2", "TASK2_PILHA", TASK2_PILHA);
+    perfil_pilha_registrar("Task3", "TASK3_PILHA", TASK3_PILHA);
+    perfil_pilha_registrar("Task4", "TASK4_PILHA", TASK4_PILHA);
+    perfil_pilha_registrar("LogDreno", "LOG_PILHA", LOG_PILHA);
+#if PRODUTORES > 1
+    perfil_pilha_registrar("Prod1", "PRODUTOR_PILHA", PRODUTOR_PILHA);
+#endif
+#if TRABALHADORES > 0
+    perfil_pilha_registrar("Trab0", "TRABALHADOR_PILHA", TRABALHADOR_PILHA);
+#endif
+#endif
+
+    if(!tasks_ok)
+    {
+        printf("{Cleber Dilenes - RM:89056} [ERROR] Falha na criação das tasks\n");
+        esp_restart(); // Só ocorre no perfil com heap
+    }
 }
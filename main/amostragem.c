@@ -0,0 +1,119 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Implementação da amostragem por gptimer
+ * Resolução do timer de 10 MHz: o período efetivo é arredondado para 0,1 µs.
+ * Os contadores só são escritos pela ISR; a leitura por outras tasks é atômica
+ * (palavras de 32 bits).
+ */
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/gptimer.h"
+#include "esp_timer.h"
+#include "esp_attr.h"
+#include "amostragem.h"
+#include "ring_spsc.h"
+#include "sistema_config.h"
+
+#define AMOSTRAGEM_RESOLUCAO_HZ 10000000 // Contagem do gptimer
+
+static gptimer_handle_t timer = NULL;
+static TaskHandle_t consumidor = NULL;
+
+static ring_spsc_t ring;
+static fila_item_t ring_buffer[AMOSTRAGEM_RING_CAP];
+
+static int contador = 0;           // "Sensor": valor crescente, como na Task1 original
+static uint32_t seq = 0;
+static uint32_t desde_notificacao = 0;
+static volatile amostragem_stats_t stats;
+
+// ==========================================
+// ISR do alarme: produtora do ring
+static bool IRAM_ATTR ao_alarme(gptimer_handle_t t, const gptimer_alarm_event_data_t *evento, void *ctx)
+{
+    BaseType_t acordou = pdFALSE;
+    fila_item_t item = {
+        .seq = seq++, // Amostras perdidas no ring também abrem lacuna
+        .t_producao = (uint32_t)esp_timer_get_time(),
+        .valor = contador++,
+        .origem = ORIGEM_AMOSTRAGEM,
+    };
+
+    stats.geradas++;
+    if(!ring_spsc_push(&ring, &item))
+        stats.descartadas++; // Consumidor atrasado: ring cheio
+
+    if(++desde_notificacao >= AMOSTRAGEM_LOTE)
+    {
+        desde_notificacao = 0;
+        vTaskNotifyGiveFromISR(consumidor, &acordou);
+    }
+    return acordou == pdTRUE;
+}
+
+// ==========================================
+bool amostragem_iniciar(uint32_t freq_hz, TaskHandle_t tarefa)
+{
+    if(timer != NULL || freq_hz == 0 || freq_hz > AMOSTRAGEM_RESOLUCAO_HZ / 2)
+        return false;
+
+    ring_spsc_init(&ring, ring_buffer, AMOSTRAGEM_RING_CAP, sizeof(fila_item_t));
+    consumidor = tarefa;
+    desde_notificacao = 0;
+    stats.freq_hz = freq_hz;
+    stats.geradas = 0;
+    stats.descartadas = 0;
+
+    gptimer_config_t config = {
+        .clk_src = GPTIMER_CLK_SRC_DEFAULT,
+        .direction = GPTIMER_COUNT_UP,
+        .resolution_hz = AMOSTRAGEM_RESOLUCAO_HZ,
+    };
+    gptimer_alarm_config_t alarme = {
+        .alarm_count = AMOSTRAGEM_RESOLUCAO_HZ / freq_hz,
+        .reload_count = 0,
+        .flags.auto_reload_on_alarm = true,
+    };
+    gptimer_event_callbacks_t callbacks = { .on_alarm = ao_alarme };
+
+    if(gptimer_new_timer(&config, &timer) != ESP_OK)
+    {
+        timer = NULL;
+        return false;
+    }
+    if(gptimer_register_event_callbacks(timer, &callbacks, NULL) != ESP_OK ||
+       gptimer_set_alarm_action(timer, &alarme) != ESP_OK ||
+       gptimer_enable(timer) != ESP_OK)
+    {
+        gptimer_del_timer(timer);
+        timer = NULL;
+        return false;
+    }
+    return gptimer_start(timer) == ESP_OK;
+}
+
+void amostragem_parar(void)
+{
+    if(timer == NULL)
+        return;
+    gptimer_stop(timer);
+    gptimer_disable(timer);
+    gptimer_del_timer(timer);
+    timer = NULL;
+}
+
+uint32_t amostragem_ler_lote(fila_item_t *destino, uint32_t max)
+{
+    return ring_spsc_pop_lote(&ring, destino, max);
+}
+
+void amostragem_estatisticas(amostragem_stats_t *s)
+{
+    s->freq_hz = stats.freq_hz;
+    s->geradas = stats.geradas;
+    s->descartadas = stats.descartadas;
+}
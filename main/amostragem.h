@@ -0,0 +1,36 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Amostragem de alta taxa por timer de hardware (gptimer)
+ * A interrupção do timer gera uma amostra por período e a coloca em um ring SPSC
+ * (a ISR é o produtor). A task consumidora é notificada a cada AMOSTRAGEM_LOTE
+ * amostras e as retira em lote, sem depender do tick de 10 ms do FreeRTOS.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "transporte.h"
+
+typedef struct
+{
+    uint32_t freq_hz;
+    uint32_t geradas;     // Amostras produzidas pela ISR
+    uint32_t descartadas; // Amostras perdidas com o ring da ISR cheio
+} amostragem_stats_t;
+
+// Inicia o timer a freq_hz. 'consumidor' recebe xTaskNotifyGive a cada lote.
+bool amostragem_iniciar(uint32_t freq_hz, TaskHandle_t consumidor);
+
+// Para e libera o timer (o ring mantém as amostras ainda não lidas).
+void amostragem_parar(void);
+
+// Consumidor: retira até 'max' amostras. Retorna quantas foram lidas.
+uint32_t amostragem_ler_lote(fila_item_t *destino, uint32_t max);
+
+// Copia os contadores da amostragem.
+void amostragem_estatisticas(amostragem_stats_t *stats);
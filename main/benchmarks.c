@@ -0,0 +1,1283 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Benchmarks de desempenho do sistema
+ * Cada benchmark imprime uma linha [BENCH] com itens/s e ciclos de CPU por item.
+ * Ciclos "entre núcleos" são estimados pelo tempo de parede (µs * MHz da CPU),
+ * pois o contador de ciclos é local a cada núcleo.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <stdatomic.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "esp_cpu.h"
+#include "esp_heap_caps.h"
+#include "sdkconfig.h"
+#include "benchmarks.h"
+#include "ring_spsc.h"
+#include "pool_blocos.h"
+#include "histograma.h"
+#include "amostragem.h"
+#include "contrapressao.h"
+#include "shards.h"
+#include "trabalhadores.h"
+#include "faixas.h"
+#include "sistema_config.h"
+
+#define BENCH_LOTE        8  // Itens por operação nos testes em lote
+#define BENCH_RING_CAP    16 // Capacidade do ring nos testes
+#define BENCH_FILA_CAP    10 // Mesma fila do sistema original: xQueueCreate(10, sizeof(int))
+
+static void imprimir_resultado(const char *nome, uint32_t itens, int64_t us, uint32_t ciclos_por_item)
+{
+    uint64_t itens_s = us > 0 ? (uint64_t)itens * 1000000ULL / (uint64_t)us : 0;
+    printf("{Cleber Dilenes - RM:89056} [BENCH] %-28s %8" PRIu64 " itens/s  %6" PRIu32 " ciclos/item\n",
+           nome, itens_s, ciclos_por_item);
+}
+
+static uint32_t ciclos_por_item_parede(int64_t us, uint32_t itens)
+{
+    return (uint32_t)((uint64_t)us * CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ / itens);
+}
+
+// ==========================================
+// Custo por item sem concorrência (mesma task faz envio e recepção)
+static void bench_custo_local(void)
+{
+    QueueHandle_t q = xQueueCreate(BENCH_FILA_CAP, sizeof(int));
+    static ring_spsc_t ring;
+    static int ring_buf[BENCH_RING_CAP];
+    ring_spsc_init(&ring, ring_buf, BENCH_RING_CAP, sizeof(int));
+
+    int v = 0, lido;
+    uint32_t c0 = esp_cpu_get_cycle_count();
+    for(uint32_t i = 0; i < BENCH_ITENS; i++)
+    {
+        xQueueSend(q, &v, 0);
+        xQueueReceive(q, &lido, 0);
+    }
+    uint32_t ciclos_fila = (esp_cpu_get_cycle_count() - c0) / BENCH_ITENS;
+
+    c0 = esp_cpu_get_cycle_count();
+    for(uint32_t i = 0; i < BENCH_ITENS; i++)
+    {
+        ring_spsc_push(&ring, &v);
+        ring_spsc_pop(&ring, &lido);
+    }
+    uint32_t ciclos_ring = (esp_cpu_get_cycle_count() - c0) / BENCH_ITENS;
+
+    printf("{Cleber Dilenes - RM:89056} [BENCH] Local envio+recepção: fila %" PRIu32 " ciclos, ring %" PRIu32 " ciclos\n",
+           ciclos_fila, ciclos_ring);
+    vQueueDelete(q);
+}
+
+// ==========================================
+// Vazão produtor -> consumidor com núcleos escolhidos
+typedef enum { MODO_FILA, MODO_RING, MODO_RING_LOTE } modo_bench_t;
+
+typedef struct
+{
+    modo_bench_t modo;
+    QueueHandle_t q;
+    ring_spsc_t *ring;
+    SemaphoreHandle_t fim;
+    int64_t t_fim;
+} bench_ctx_t;
+
+static void bench_produtor(void *pv)
+{
+    bench_ctx_t *ctx = pv;
+    int lote[BENCH_LOTE];
+
+    for(uint32_t i = 0; i < BENCH_ITENS; )
+    {
+        switch(ctx->modo)
+        {
+        case MODO_FILA:
+            xQueueSend(ctx->q, &i, portMAX_DELAY);
+            i++;
+            break;
+        case MODO_RING:
+            if(ring_spsc_push(ctx->ring, &i))
+                i++;
+            break;
+        case MODO_RING_LOTE:
+            for(int k = 0; k < BENCH_LOTE; k++)
+                lote[k] = i + k;
+            i += ring_spsc_push_lote(ctx->ring, lote, BENCH_LOTE);
+            break;
+        }
+    }
+    xSemaphoreGive(ctx->fim);
+    vTaskDelete(NULL);
+}
+
+static void bench_consumidor(void *pv)
+{
+    bench_ctx_t *ctx = pv;
+    int lote[BENCH_LOTE];
+
+    for(uint32_t i = 0; i < BENCH_ITENS; )
+    {
+        switch(ctx->modo)
+        {
+        case MODO_FILA:
+            if(xQueueReceive(ctx->q, lote, portMAX_DELAY) == pdTRUE)
+                i++;
+            break;
+        case MODO_RING:
+            if(ring_spsc_pop(ctx->ring, lote))
+                i++;
+            break;
+        case MODO_RING_LOTE:
+            i += ring_spsc_pop_lote(ctx->ring, lote, BENCH_LOTE);
+            break;
+        }
+    }
+    ctx->t_fim = esp_timer_get_time();
+    xSemaphoreGive(ctx->fim);
+    vTaskDelete(NULL);
+}
+
+static void bench_vazao(modo_bench_t modo, const char *nome, BaseType_t nucleo_prod, BaseType_t nucleo_cons)
+{
+    static ring_spsc_t ring;
+    static int ring_buf[BENCH_RING_CAP];
+    bench_ctx_t ctx = { .modo = modo, .ring = &ring };
+
+    ring_spsc_init(&ring, ring_buf, BENCH_RING_CAP, sizeof(int));
+    ctx.q = xQueueCreate(BENCH_FILA_CAP, sizeof(int));
+    ctx.fim = xSemaphoreCreateCounting(2, 0);
+    if(ctx.q == NULL || ctx.fim == NULL)
+    {
+        printf("{Cleber Dilenes - RM:89056} [BENCH] Falha ao criar recursos do benchmark\n");
+        return;
+    }
+
+    int64_t t0 = esp_timer_get_time();
+    xTaskCreatePinnedToCore(bench_consumidor, "bench_cons", 4096, &ctx, 6, NULL, nucleo_cons);
+    xTaskCreatePinnedToCore(bench_produtor, "bench_prod", 4096, &ctx, 6, NULL, nucleo_prod);
+
+    xSemaphoreTake(ctx.fim, portMAX_DELAY);
+    xSemaphoreTake(ctx.fim, portMAX_DELAY);
+
+    int64_t us = ctx.t_fim - t0;
+    imprimir_resultado(nome, BENCH_ITENS, us, ciclos_por_item_parede(us, BENCH_ITENS));
+
+    vSemaphoreDelete(ctx.fim);
+    vQueueDelete(ctx.q);
+}
+
+// ==========================================
+// Latência de handoff pela fila: ida e volta medida pelo contador de ciclos
+// do núcleo de origem; a latência de uma via é metade da ida e volta.
+typedef struct
+{
+    QueueHandle_t ida;
+    QueueHandle_t volta;
+    histograma_t *ciclos;
+    SemaphoreHandle_t fim;
+} pingue_ctx_t;
+
+static void bench_eco(void *pv)
+{
+    pingue_ctx_t *ctx = pv;
+    uint32_t v;
+
+    for(uint32_t i = 0; i < BENCH_PINGUE; i++)
+    {
+        xQueueReceive(ctx->ida, &v, portMAX_DELAY);
+        xQueueSend(ctx->volta, &v, portMAX_DELAY);
+    }
+    xSemaphoreGive(ctx->fim);
+    vTaskDelete(NULL);
+}
+
+static void bench_pingue(void *pv)
+{
+    pingue_ctx_t *ctx = pv;
+    uint32_t v;
+
+    for(uint32_t i = 0; i < BENCH_PINGUE; i++)
+    {
+        uint32_t c0 = esp_cpu_get_cycle_count();
+        xQueueSend(ctx->ida, &i, portMAX_DELAY);
+        xQueueReceive(ctx->volta, &v, portMAX_DELAY);
+        histograma_registrar(ctx->ciclos, (esp_cpu_get_cycle_count() - c0) / 2);
+    }
+    xSemaphoreGive(ctx->fim);
+    vTaskDelete(NULL);
+}
+
+static void bench_handoff(const char *nome, BaseType_t nucleo_origem, BaseType_t nucleo_destino)
+{
+    static histograma_t ciclos;
+    pingue_ctx_t ctx = { .ciclos = &ciclos };
+    histograma_resumo_t r;
+
+    histograma_init(&ciclos);
+    ctx.ida = xQueueCreate(1, sizeof(uint32_t));
+    ctx.volta = xQueueCreate(1, sizeof(uint32_t));
+    ctx.fim = xSemaphoreCreateCounting(2, 0);
+    if(ctx.ida == NULL || ctx.volta == NULL || ctx.fim == NULL)
+    {
+        printf("{Cleber Dilenes - RM:89056} [BENCH] Falha ao criar recursos do benchmark\n");
+        return;
+    }
+
+    xTaskCreatePinnedToCore(bench_eco, "bench_eco", 4096, &ctx, 6, NULL, nucleo_destino);
+    xTaskCreatePinnedToCore(bench_pingue, "bench_pingue", 4096, &ctx, 6, NULL, nucleo_origem);
+    xSemaphoreTake(ctx.fim, portMAX_DELAY);
+    xSemaphoreTake(ctx.fim, portMAX_DELAY);
+
+    histograma_resumo(&ciclos, &r);
+    printf("{Cleber Dilenes - RM:89056} [BENCH] Handoff %-22s p50 %5lu  p99 %5lu  máx %6lu ciclos (%lu ns p50)\n",
+           nome, r.p50, r.p99, r.maximo, r.p50 * 1000 / CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ);
+
+    vSemaphoreDelete(ctx.fim);
+    vQueueDelete(ctx.ida);
+    vQueueDelete(ctx.volta);
+}
+
+// Mesmo núcleo x núcleos diferentes, para escolher PERFIL_AFINIDADE
+static void bench_afinidade(void)
+{
+    bench_handoff("mesmo núcleo (0->0)", 0, 0);
+    bench_handoff("mesmo núcleo (1->1)", 1, 1);
+    bench_handoff("entre núcleos (0->1)", 0, 1);
+    bench_handoff("entre núcleos (1->0)", 1, 0);
+
+    bench_vazao(MODO_FILA, "fila mesmo núcleo (1->1)", 1, 1);
+    bench_vazao(MODO_FILA, "fila entre núcleos (0->1)", 0, 1);
+    bench_vazao(MODO_FILA, "fila entre núcleos (1->0)", 1, 0);
+}
+
+// ==========================================
+// Taxa máxima sustentada da amostragem por timer: ISR -> ring -> task de lote
+// -> ring do transporte -> task consumidora em outro núcleo. Cada taxa roda
+// por 1 s; a maior taxa sem nenhuma perda é o resultado.
+typedef struct
+{
+    ring_spsc_t *transporte;
+    TaskHandle_t consumidor;
+    volatile uint32_t recebidas;
+    volatile uint32_t perdidas_fila;
+} taxa_ctx_t;
+
+static void bench_taxa_lote(void *pv)
+{
+    taxa_ctx_t *ctx = pv;
+    static fila_item_t lote[AMOSTRAGEM_LOTE];
+
+    while(1)
+    {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(10));
+        uint32_t n;
+        while((n = amostragem_ler_lote(lote, AMOSTRAGEM_LOTE)) > 0)
+        {
+            ctx->perdidas_fila += n - ring_spsc_push_lote(ctx->transporte, lote, n);
+            xTaskNotifyGive(ctx->consumidor);
+        }
+    }
+}
+
+static void bench_taxa_consumidor(void *pv)
+{
+    taxa_ctx_t *ctx = pv;
+    static fila_item_t lote[AMOSTRAGEM_LOTE];
+
+    while(1)
+    {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(10));
+        uint32_t n;
+        while((n = ring_spsc_pop_lote(ctx->transporte, lote, AMOSTRAGEM_LOTE)) > 0)
+            ctx->recebidas += n;
+    }
+}
+
+static void bench_taxa_maxima(void)
+{
+    static const uint32_t taxas_hz[] = { 5000, 10000, 20000, 30000, 40000, 50000, 75000, 100000 };
+    static ring_spsc_t ring;
+    static fila_item_t ring_buf[256];
+    taxa_ctx_t ctx = { .transporte = &ring };
+    TaskHandle_t lote = NULL;
+    uint32_t maxima = 0;
+
+    ring_spsc_init(&ring, ring_buf, 256, sizeof(fila_item_t));
+    xTaskCreatePinnedToCore(bench_taxa_consumidor, "bench_taxa_c", 4096, &ctx, 6, &ctx.consumidor, 1);
+    xTaskCreatePinnedToCore(bench_taxa_lote, "bench_taxa_l", 4096, &ctx, 6, &lote, 0);
+
+    for(size_t i = 0; i < sizeof(taxas_hz) / sizeof(taxas_hz[0]); i++)
+    {
+        amostragem_stats_t st;
+        ctx.recebidas = 0;
+        ctx.perdidas_fila = 0;
+
+        if(!amostragem_iniciar(taxas_hz[i], lote))
+            break;
+        vTaskDelay(pdMS_TO_TICKS(1000));
+        amostragem_parar();
+        vTaskDelay(pdMS_TO_TICKS(50)); // Esvazia o pipeline
+        amostragem_estatisticas(&st);
+
+        uint32_t perdidas = st.descartadas + ctx.perdidas_fila;
+        printf("{Cleber Dilenes - RM:89056} [BENCH] Amostragem %6lu Hz: geradas %lu, recebidas %lu, perdidas ISR %lu, fila %lu\n",
+               taxas_hz[i], st.geradas, ctx.recebidas, st.descartadas, ctx.perdidas_fila);
+        if(perdidas == 0 && ctx.recebidas == st.geradas)
+            maxima = taxas_hz[i];
+        else
+            break; // Acima desta taxa o pipeline já perde amostras
+    }
+
+    printf("{Cleber Dilenes - RM:89056} [BENCH] Taxa máxima sustentada sem perdas: %lu Hz\n", maxima);
+    vTaskDelete(lote);
+    vTaskDelete(ctx.consumidor);
+}
+
+// ==========================================
+// Soak do pool de blocos: milhões de ciclos alocar/liberar com padrão irregular
+// (blocos retidos trocados fora de ordem, tamanhos de 16 a 64 B), amostrando a
+// fragmentação do heap (1 - maior bloco livre / heap livre). O mesmo padrão roda
+// primeiro com malloc/free, como referência, e depois pelo pool.
+#define SOAK_AMOSTRAS   10 // Pontos de medição ao longo do soak
+#define SOAK_RETIDOS    5  // Blocos mantidos alocados entre ciclos
+#define SOAK_BLOCO      64 // Maior pedido do padrão = tamanho do bloco do pool
+
+typedef struct
+{
+    const char *nome;
+    void *(*alocar)(size_t tamanho);
+    void (*liberar)(void *bloco);
+} soak_alocador_t;
+
+typedef struct
+{
+    uint32_t frag_inicio;  // Permil, antes da rodada
+    uint32_t frag_max;
+    size_t livre_inicio;
+    size_t livre_min;      // Menor heap livre observado com os blocos retidos
+    size_t maior_min;      // Menor "maior bloco livre" observado
+    size_t livre_fim;      // Heap livre depois de devolver tudo
+    uint32_t ciclos_op;    // Ciclos por alocar+liberar
+    uint32_t falhas;
+} soak_resultado_t;
+
+static pool_blocos_t soak_pool;
+POOL_BLOCOS_MEMORIA(soak_mem, SOAK_BLOCO, 8);
+
+static void *soak_pool_alocar(size_t tamanho)
+{
+    return tamanho <= SOAK_BLOCO ? pool_blocos_alocar(&soak_pool) : NULL;
+}
+
+static void soak_pool_liberar(void *bloco)
+{
+    pool_blocos_liberar(&soak_pool, bloco);
+}
+
+static uint32_t fragmentacao_permil(void)
+{
+    size_t livre = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    size_t maior = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+    return livre > 0 ? (uint32_t)(1000 - (uint64_t)maior * 1000 / livre) : 0;
+}
+
+static void soak_rodada(const soak_alocador_t *a, soak_resultado_t *r)
+{
+    void *retidos[SOAK_RETIDOS] = {0};
+    int64_t t0 = esp_timer_get_time();
+
+    *r = (soak_resultado_t){
+        .frag_inicio = fragmentacao_permil(),
+        .livre_inicio = heap_caps_get_free_size(MALLOC_CAP_8BIT),
+        .livre_min = SIZE_MAX,
+        .maior_min = SIZE_MAX,
+    };
+    r->frag_max = r->frag_inicio;
+
+    for(uint32_t amostra = 1; amostra <= SOAK_AMOSTRAS; amostra++)
+    {
+        for(uint32_t i = 0; i < SOAK_CICLOS / SOAK_AMOSTRAS; i++)
+        {
+            // Troca um bloco retido por um novo, em ordem pseudoaleatória
+            uint32_t hash = i * 2654435761u;
+            uint32_t k = hash % SOAK_RETIDOS;
+            size_t tamanho = 16 + (hash >> 16) % (SOAK_BLOCO - 15);
+            if(retidos[k] != NULL)
+                a->liberar(retidos[k]);
+            retidos[k] = a->alocar(tamanho);
+
+            void *temp = a->alocar(SOAK_BLOCO + 16 - tamanho);
+            if(retidos[k] == NULL || temp == NULL)
+                r->falhas++;
+            if(temp != NULL)
+                a->liberar(temp);
+        }
+
+        uint32_t frag = fragmentacao_permil();
+        size_t livre = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+        size_t maior = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+        if(frag > r->frag_max)
+            r->frag_max = frag;
+        if(livre < r->livre_min)
+            r->livre_min = livre;
+        if(maior < r->maior_min)
+            r->maior_min = maior;
+        printf("{Cleber Dilenes - RM:89056} [SOAK] %-6s %3lu%%  heap livre %u  maior bloco %u  fragmentação %lu.%lu%%\n",
+               a->nome, amostra * 100 / SOAK_AMOSTRAS, livre, maior, frag / 10, frag % 10);
+        vTaskDelay(1); // Deixa a idle task alimentar o WDT
+    }
+
+    // O atraso de 1 tick por amostra entra no tempo, igual para os dois alocadores
+    int64_t us = esp_timer_get_time() - t0;
+    r->ciclos_op = ciclos_por_item_parede(us, SOAK_CICLOS * 2);
+
+    for(int k = 0; k < SOAK_RETIDOS; k++)
+        if(retidos[k] != NULL)
+            a->liberar(retidos[k]);
+    r->livre_fim = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+}
+
+static void bench_soak_pool(void)
+{
+    static const soak_alocador_t heap = { "malloc", malloc, free };
+    static const soak_alocador_t pool = { "pool", soak_pool_alocar, soak_pool_liberar };
+    soak_resultado_t rm, rp;
+
+    pool_blocos_init(&soak_pool, "soak", soak_mem, SOAK_BLOCO, 8);
+
+    soak_rodada(&heap, &rm);
+    soak_rodada(&pool, &rp);
+
+    pool_blocos_stats_t stats;
+    pool_blocos_estatisticas(&soak_pool, &stats);
+
+    // O pool não pode tocar o heap: nem consumo, nem fragmentação além da inicial
+    bool ok = rp.livre_min == rp.livre_inicio && rp.livre_fim == rp.livre_inicio && rp.frag_max == rp.frag_inicio &&
+              rp.falhas == 0 && stats.falhas == 0;
+
+    printf("{Cleber Dilenes - RM:89056} [SOAK] malloc: frag máx %lu.%lu%%, heap mín %u, maior bloco mín %u, "
+           "%lu ciclos/op, falhas %lu, heap %u -> %u\n",
+           rm.frag_max / 10, rm.frag_max % 10, rm.livre_min, rm.maior_min, rm.ciclos_op, rm.falhas,
+           rm.livre_inicio, rm.livre_fim);
+    printf("{Cleber Dilenes - RM:89056} [SOAK] pool:   frag máx %lu.%lu%%, heap mín %u, maior bloco mín %u, "
+           "%lu ciclos/op, falhas %lu, pico %lu blocos\n",
+           rp.frag_max / 10, rp.frag_max % 10, rp.livre_min, rp.maior_min, rp.ciclos_op, rp.falhas, stats.pico);
+    printf("{Cleber Dilenes - RM:89056} [SOAK] %s: %d ciclos por alocador, pool x malloc: fragmentação %lu.%lu%% x "
+           "%lu.%lu%%, %lu x %lu ciclos/op\n",
+           ok ? "OK" : "FALHA", SOAK_CICLOS, rp.frag_max / 10, rp.frag_max % 10, rm.frag_max / 10, rm.frag_max % 10,
+           rp.ciclos_op, rm.ciclos_op);
+}
+
+// ==========================================
+// Cópia x zero-copy entre núcleos: a fila copia o quadro inteiro na ida e na
+// volta; no modo sem cópia o quadro vem de um pool e só o ponteiro passa pela fila.
+#define ZC_FILA_CAP  4 // Quadros em trânsito
+#define ZC_BLOCOS    (ZC_FILA_CAP + 2)
+
+typedef struct
+{
+    bool zero_copia;
+    uint32_t tamanho;
+    QueueHandle_t q;
+    pool_blocos_t *pool;
+    uint8_t *quadro;   // Quadro do produtor no modo cópia
+    uint8_t *recebido; // Quadro do consumidor no modo cópia
+    SemaphoreHandle_t fim;
+    int64_t t_fim;
+    uint32_t soma;     // Evita que o consumo seja eliminado pelo compilador
+} zc_ctx_t;
+
+static void bench_zc_produtor(void *pv)
+{
+    zc_ctx_t *ctx = pv;
+
+    for(uint32_t i = 0; i < BENCH_ZC_ITENS; i++)
+    {
+        if(ctx->zero_copia)
+        {
+            uint8_t *bloco;
+            while((bloco = pool_blocos_alocar(ctx->pool)) == NULL)
+                taskYIELD(); // Todos os blocos em trânsito: espera o consumidor devolver
+            bloco[0] = (uint8_t)i;
+            xQueueSend(ctx->q, &bloco, portMAX_DELAY);
+        }
+        else
+        {
+            ctx->quadro[0] = (uint8_t)i;
+            xQueueSend(ctx->q, ctx->quadro, portMAX_DELAY);
+        }
+    }
+    xSemaphoreGive(ctx->fim);
+    vTaskDelete(NULL);
+}
+
+static void bench_zc_consumidor(void *pv)
+{
+    zc_ctx_t *ctx = pv;
+
+    for(uint32_t i = 0; i < BENCH_ZC_ITENS; i++)
+    {
+        if(ctx->zero_copia)
+        {
+            uint8_t *bloco;
+            xQueueReceive(ctx->q, &bloco, portMAX_DELAY);
+            ctx->soma += bloco[0];
+            pool_blocos_liberar(ctx->pool, bloco);
+        }
+        else
+        {
+            xQueueReceive(ctx->q, ctx->recebido, portMAX_DELAY);
+            ctx->soma += ctx->recebido[0];
+        }
+    }
+    ctx->t_fim = esp_timer_get_time();
+    xSemaphoreGive(ctx->fim);
+    vTaskDelete(NULL);
+}
+
+static void bench_zc_rodada(uint32_t tamanho, bool zero_copia)
+{
+    static pool_blocos_t pool;
+    zc_ctx_t ctx = { .zero_copia = zero_copia, .tamanho = tamanho, .pool = &pool };
+    void *mem = NULL;
+    char nome[40];
+
+    snprintf(nome, sizeof(nome), "%s %lu B", zero_copia ? "zero-copy" : "cópia", tamanho);
+
+    // Buffers alocados em tempo de execução: só existem durante a rodada
+    if(zero_copia)
+    {
+        mem = heap_caps_aligned_alloc(POOL_ALINHAMENTO, POOL_TAMANHO_BLOCO(tamanho) * ZC_BLOCOS, MALLOC_CAP_8BIT);
+        ctx.q = xQueueCreate(ZC_FILA_CAP, sizeof(uint8_t *));
+        if(!pool_blocos_init(&pool, "zc", mem, tamanho, ZC_BLOCOS))
+        {
+            heap_caps_free(mem);
+            mem = NULL;
+        }
+    }
+    else
+    {
+        mem = heap_caps_malloc(2 * tamanho, MALLOC_CAP_8BIT);
+        ctx.q = xQueueCreate(ZC_FILA_CAP, tamanho);
+        ctx.quadro = mem;
+        ctx.recebido = (uint8_t *)mem + tamanho;
+    }
+    ctx.fim = xSemaphoreCreateCounting(2, 0);
+    if(mem == NULL || ctx.q == NULL || ctx.fim == NULL)
+    {
+        printf("{Cleber Dilenes - RM:89056} [BENCH] Falha ao criar recursos do benchmark (%s)\n", nome);
+    }
+    else
+    {
+        int64_t t0 = esp_timer_get_time();
+        xTaskCreatePinnedToCore(bench_zc_consumidor, "bench_zc_c", 4096, &ctx, 6, NULL, 1);
+        xTaskCreatePinnedToCore(bench_zc_produtor, "bench_zc_p", 4096, &ctx, 6, NULL, 0);
+        xSemaphoreTake(ctx.fim, portMAX_DELAY);
+        xSemaphoreTake(ctx.fim, portMAX_DELAY);
+
+        int64_t us = ctx.t_fim - t0;
+        imprimir_resultado(nome, BENCH_ZC_ITENS, us, ciclos_por_item_parede(us, BENCH_ZC_ITENS));
+    }
+
+    if(ctx.fim != NULL)
+        vSemaphoreDelete(ctx.fim);
+    if(ctx.q != NULL)
+        vQueueDelete(ctx.q);
+    heap_caps_free(mem);
+}
+
+static void bench_zero_copia(void)
+{
+    static const uint32_t tamanhos[] = { 4, 256, 4096 };
+
+    for(uint32_t i = 0; i < sizeof(tamanhos) / sizeof(tamanhos[0]); i++)
+    {
+        bench_zc_rodada(tamanhos[i], false);
+        bench_zc_rodada(tamanhos[i], true);
+    }
+}
+
+// ==========================================
+// Contrapressão sob rajadas: o produtor gera rajadas maiores que a fila e o
+// consumidor leva CP_CONSUMO_US por item. Cada política troca perdas por
+// latência (ou por tempo de produtor bloqueado).
+#define CP_FILA_CAP     8
+#define CP_RAJADAS      50
+#define CP_RAJADA       32   // Itens por rajada (4x a fila)
+#define CP_PAUSA_MS     20   // Intervalo entre rajadas: a média cabe no consumidor
+#define CP_CONSUMO_US   250  // Processamento de cada item no consumidor
+
+static QueueHandle_t cp_fila;
+
+static bool cp_enviar(const fila_item_t *item)
+{
+    return xQueueSend(cp_fila, item, 0) == pdTRUE;
+}
+
+typedef struct
+{
+    histograma_t latencia;
+    volatile bool produtor_terminou;
+    SemaphoreHandle_t fim;
+    uint32_t recebidos;
+} cp_ctx_t;
+
+static void bench_cp_consumidor(void *pv)
+{
+    cp_ctx_t *ctx = pv;
+    fila_item_t item;
+
+    while(1)
+    {
+        if(xQueueReceive(cp_fila, &item, pdMS_TO_TICKS(50)) == pdTRUE)
+        {
+            histograma_registrar(&ctx->latencia, (uint32_t)esp_timer_get_time() - item.t_producao);
+            ctx->recebidos++;
+            int64_t ate = esp_timer_get_time() + CP_CONSUMO_US;
+            while(esp_timer_get_time() < ate)
+                ; // Simula o processamento
+        }
+        else if(ctx->produtor_terminou)
+        {
+            break;
+        }
+    }
+    xSemaphoreGive(ctx->fim);
+    vTaskDelete(NULL);
+}
+
+static void bench_contrapressao_politica(uint32_t politica)
+{
+    static cp_ctx_t ctx;
+    static contrapressao_t cp;
+
+    histograma_init(&ctx.latencia);
+    ctx.produtor_terminou = false;
+    ctx.recebidos = 0;
+    ctx.fim = xSemaphoreCreateBinary();
+    cp_fila = xQueueCreate(CP_FILA_CAP, sizeof(fila_item_t));
+    if(ctx.fim == NULL || cp_fila == NULL)
+    {
+        printf("{Cleber Dilenes - RM:89056} [BENCH] Falha ao criar recursos do benchmark\n");
+        return;
+    }
+    contrapressao_init(&cp, politica, cp_enviar);
+    xTaskCreatePinnedToCore(bench_cp_consumidor, "bench_cp_c", 4096, &ctx, 5, NULL, 1);
+
+    // Produtor: esta task (núcleo 0), como a Task1
+    int valor = 0;
+    for(int r = 0; r < CP_RAJADAS; r++)
+    {
+        for(int k = 0; k < CP_RAJADA; k++)
+        {
+            fila_item_t item = { .valor = valor++, .t_producao = (uint32_t)esp_timer_get_time() };
+            contrapressao_enviar(&cp, &item);
+        }
+        for(TickType_t t = 0; t < pdMS_TO_TICKS(CP_PAUSA_MS); t++)
+        {
+            vTaskDelay(1);
+            contrapressao_escoar(&cp);
+        }
+    }
+    while(contrapressao_escoar(&cp) > 0)
+        vTaskDelay(1);
+    ctx.produtor_terminou = true;
+    xSemaphoreTake(ctx.fim, portMAX_DELAY);
+
+    histograma_resumo_t lat;
+    histograma_resumo(&ctx.latencia, &lat);
+    uint32_t total = CP_RAJADAS * CP_RAJADA;
+    printf("{Cleber Dilenes - RM:89056} [BENCH] Contrapressão %-16s perda %3lu.%lu%%  latência p50 %6lu us p99 %6lu us  "
+           "bloqueado %5llu ms\n",
+           contrapressao_nome(politica), cp.stats.descartados * 100 / total,
+           cp.stats.descartados * 1000 / total % 10, lat.p50, lat.p99, cp.stats.bloqueado_us / 1000);
+
+    vSemaphoreDelete(ctx.fim);
+    vQueueDelete(cp_fila);
+}
+
+static void bench_contrapressao(void)
+{
+    for(uint32_t p = CONTRAPRESSAO_DESCARTAR_NOVO; p <= CONTRAPRESSAO_TRANSBORDO; p++)
+        bench_contrapressao_politica(p);
+}
+
+// ==========================================
+// Fan-in de 1 a 16 produtores para um consumidor: fila única compartilhada
+// (todos disputam a mesma trava), uma fila por produtor unidas por QueueSet e
+// um ring SPSC por produtor com mescla em rodízio (shards.c). O total de itens
+// é fixo e dividido entre os produtores, alternados entre os núcleos.
+#define FANIN_MAX 16
+#define FANIN_CAP 16 // Posições por fila/shard
+
+// Fila única, QueueSet e shards recebem um item por chamada; "shards lote" é
+// a mesma mescla retirando BENCH_LOTE itens por chamada, como no transporte.
+typedef enum { FANIN_FILA_UNICA, FANIN_CONJUNTO, FANIN_SHARDS, FANIN_SHARDS_LOTE } modo_fanin_t;
+
+typedef struct
+{
+    modo_fanin_t modo;
+    uint32_t produtores;
+    QueueHandle_t filas[FANIN_MAX]; // Só filas[0] na fila única
+    QueueSetHandle_t conjunto;
+    shards_t *shards;
+    SemaphoreHandle_t fim;
+    int64_t t_fim;
+    uint32_t fora_de_ordem;         // Sequência de um produtor que não chegou em ordem
+} fanin_ctx_t;
+
+typedef struct
+{
+    fanin_ctx_t *ctx;
+    uint32_t k;
+} fanin_produtor_t;
+
+static void bench_fanin_produtor(void *pv)
+{
+    fanin_produtor_t *arg = pv;
+    fanin_ctx_t *ctx = arg->ctx;
+    uint32_t n = BENCH_FANIN_ITENS / ctx->produtores;
+    fila_item_t item = { .origem = arg->k };
+
+    for(item.seq = 0; item.seq < n; )
+    {
+        switch(ctx->modo)
+        {
+        case FANIN_FILA_UNICA:
+            xQueueSend(ctx->filas[0], &item, portMAX_DELAY);
+            item.seq++;
+            break;
+        case FANIN_CONJUNTO:
+            xQueueSend(ctx->filas[arg->k], &item, portMAX_DELAY);
+            item.seq++;
+            break;
+        case FANIN_SHARDS:
+        case FANIN_SHARDS_LOTE:
+            if(shards_push(ctx->shards, arg->k, &item))
+                item.seq++;
+            else
+                taskYIELD(); // Shard cheio: cede o núcleo aos outros produtores
+            break;
+        }
+    }
+    xSemaphoreGive(ctx->fim);
+    vTaskDelete(NULL);
+}
+
+static void bench_fanin_consumidor(void *pv)
+{
+    fanin_ctx_t *ctx = pv;
+    uint32_t proximo[FANIN_MAX] = { 0 };
+    fila_item_t lote[BENCH_LOTE];
+
+    for(uint32_t i = 0; i < BENCH_FANIN_ITENS; )
+    {
+        uint32_t lidos = 0;
+        switch(ctx->modo)
+        {
+        case FANIN_FILA_UNICA:
+            lidos = xQueueReceive(ctx->filas[0], lote, portMAX_DELAY) == pdTRUE;
+            break;
+        case FANIN_CONJUNTO:
+        {
+            QueueSetMemberHandle_t membro = xQueueSelectFromSet(ctx->conjunto, portMAX_DELAY);
+            lidos = membro != NULL && xQueueReceive(membro, lote, 0) == pdTRUE;
+            break;
+        }
+        case FANIN_SHARDS:
+        case FANIN_SHARDS_LOTE:
+            lidos = ctx->modo == FANIN_SHARDS ? (uint32_t)shards_pop(ctx->shards, lote)
+                                              : shards_pop_lote(ctx->shards, lote, BENCH_LOTE);
+            if(lidos == 0)
+                taskYIELD();
+            break;
+        }
+
+        for(uint32_t j = 0; j < lidos; j++)
+        {
+            if(lote[j].seq != proximo[lote[j].origem])
+                ctx->fora_de_ordem++;
+            proximo[lote[j].origem] = lote[j].seq + 1;
+        }
+        i += lidos;
+    }
+    ctx->t_fim = esp_timer_get_time();
+    xSemaphoreGive(ctx->fim);
+    vTaskDelete(NULL);
+}
+
+static void bench_fanin_rodada(modo_fanin_t modo, uint32_t produtores)
+{
+    static const char *const nomes[] = { "fila única", "QueueSet", "shards SPSC", "shards lote 8" };
+    static shards_t shards;
+    static fila_item_t shards_buf[FANIN_MAX * FANIN_CAP];
+    static fanin_produtor_t args[FANIN_MAX];
+    fanin_ctx_t ctx = { .modo = modo, .produtores = produtores, .shards = &shards };
+    uint32_t filas = modo == FANIN_FILA_UNICA ? 1 : modo == FANIN_CONJUNTO ? produtores : 0;
+    bool ok = true;
+
+    shards_init(&shards, shards_buf, produtores, FANIN_CAP, FILA_MESCLA_RODIZIO);
+    ctx.fim = xSemaphoreCreateCounting(produtores + 1, 0);
+    for(uint32_t k = 0; k < filas; k++)
+        ok &= (ctx.filas[k] = xQueueCreate(FANIN_CAP, sizeof(fila_item_t))) != NULL;
+    if(modo == FANIN_CONJUNTO && ok)
+    {
+        ctx.conjunto = xQueueCreateSet(produtores * FANIN_CAP);
+        for(uint32_t k = 0; k < filas && ctx.conjunto != NULL; k++)
+            xQueueAddToSet(ctx.filas[k], ctx.conjunto);
+        ok = ctx.conjunto != NULL;
+    }
+    if(!ok || ctx.fim == NULL)
+    {
+        printf("{Cleber Dilenes - RM:89056} [BENCH] Falha ao criar recursos do benchmark\n");
+        return;
+    }
+
+    int64_t t0 = esp_timer_get_time();
+    xTaskCreatePinnedToCore(bench_fanin_consumidor, "fanin_cons", 4096, &ctx, 6, NULL, 1);
+    for(uint32_t k = 0; k < produtores; k++)
+    {
+        args[k] = (fanin_produtor_t){ .ctx = &ctx, .k = k };
+        xTaskCreatePinnedToCore(bench_fanin_produtor, "fanin_prod", 4096, &args[k], 6, NULL, k % portNUM_PROCESSORS);
+    }
+    for(uint32_t k = 0; k <= produtores; k++)
+        xSemaphoreTake(ctx.fim, portMAX_DELAY);
+
+    char nome[32];
+    snprintf(nome, sizeof(nome), "fan-in %2lu prod %s", produtores, nomes[modo]);
+    int64_t us = ctx.t_fim - t0;
+    imprimir_resultado(nome, BENCH_FANIN_ITENS, us, ciclos_por_item_parede(us, BENCH_FANIN_ITENS));
+    if(ctx.fora_de_ordem > 0)
+        printf("{Cleber Dilenes - RM:89056} [BENCH] %s: %lu itens fora de ordem\n", nome, ctx.fora_de_ordem);
+
+    // Membros só saem do conjunto vazios; o conjunto é apagado depois deles
+    for(uint32_t k = 0; k < filas; k++)
+    {
+        if(ctx.conjunto != NULL)
+            xQueueRemoveFromSet(ctx.filas[k], ctx.conjunto);
+        vQueueDelete(ctx.filas[k]);
+    }
+    if(ctx.conjunto != NULL)
+        vQueueDelete(ctx.conjunto);
+    vSemaphoreDelete(ctx.fim);
+}
+
+static void bench_produtores(void)
+{
+    for(uint32_t p = 1; p <= FANIN_MAX; p *= 2)
+    {
+        bench_fanin_rodada(FANIN_FILA_UNICA, p);
+        bench_fanin_rodada(FANIN_CONJUNTO, p);
+        bench_fanin_rodada(FANIN_SHARDS, p);
+        bench_fanin_rodada(FANIN_SHARDS_LOTE, p);
+    }
+}
+
+// ==========================================
+// Pool de trabalhadores x laço único: o mesmo custo por item processado por
+// uma task só ou por um trabalhador em cada núcleo, alimentados por uma task
+// que faz o papel da Task2. Na carga irregular os itens pares custam 3x e
+// caem todos no mesmo deque pelo rodízio: o equilíbrio depende dos roubos.
+static bool trabalho_irregular;
+
+static void bench_trabalho_item(const fila_item_t *item)
+{
+    trabalho_carga(trabalho_irregular && item->valor % 2 == 0 ? 3 * BENCH_TRABALHO_CICLOS : BENCH_TRABALHO_CICLOS);
+}
+
+typedef struct
+{
+    trabalhadores_t *pool;  // NULL: processa no próprio laço
+    SemaphoreHandle_t fim;
+} trabalho_ctx_t;
+
+static void bench_trabalho_alimentador(void *pv)
+{
+    trabalho_ctx_t *ctx = pv;
+
+    for(uint32_t i = 0; i < BENCH_TRABALHO_ITENS; )
+    {
+        fila_item_t item = { .seq = i, .valor = (int)i };
+        if(ctx->pool == NULL)
+            bench_trabalho_item(&item);
+        else if(!trabalhadores_enviar(ctx->pool, &item))
+        {
+            taskYIELD(); // Deques cheios: cede o núcleo ao trabalhador
+            continue;
+        }
+        i++;
+    }
+    if(ctx->pool != NULL)
+        trabalhadores_parar(ctx->pool); // Espera os deques esvaziarem
+    xSemaphoreGive(ctx->fim);
+    vTaskDelete(NULL);
+}
+
+static int64_t bench_trabalho_rodada(trabalhadores_t *pool, bool irregular)
+{
+    trabalho_ctx_t ctx = { .pool = pool, .fim = xSemaphoreCreateBinary() };
+    if(ctx.fim == NULL || (pool != NULL && !trabalhadores_iniciar(pool, portNUM_PROCESSORS, bench_trabalho_item, 6, NULL, NULL)))
+    {
+        printf("{Cleber Dilenes - RM:89056} [BENCH] Falha ao criar recursos do benchmark\n");
+        if(ctx.fim != NULL)
+            vSemaphoreDelete(ctx.fim);
+        return 0;
+    }
+
+    trabalho_irregular = irregular;
+    int64_t t0 = esp_timer_get_time();
+    xTaskCreatePinnedToCore(bench_trabalho_alimentador, "trab_alim", 4096, &ctx, 6, NULL, 1);
+    xSemaphoreTake(ctx.fim, portMAX_DELAY);
+    int64_t us = esp_timer_get_time() - t0;
+
+    vSemaphoreDelete(ctx.fim);
+    return us;
+}
+
+static void bench_trabalhadores(void)
+{
+    static trabalhadores_t pool;
+
+    for(int irregular = 0; irregular <= 1; irregular++)
+    {
+        int64_t us_laco = bench_trabalho_rodada(NULL, irregular);
+        int64_t us_pool = bench_trabalho_rodada(&pool, irregular);
+        if(us_laco == 0 || us_pool == 0)
+            return;
+
+        trabalhador_stats_t total;
+        trabalhadores_total(&pool, &total);
+        uint32_t ganho = (uint32_t)(us_laco * 100 / us_pool); // Centésimos
+        const char *carga = irregular ? "irregular" : "uniforme";
+
+        char nome[40];
+        snprintf(nome, sizeof(nome), "trabalho laço único %s", carga);
+        imprimir_resultado(nome, BENCH_TRABALHO_ITENS, us_laco, ciclos_por_item_parede(us_laco, BENCH_TRABALHO_ITENS));
+        snprintf(nome, sizeof(nome), "trabalho pool %dx %s", portNUM_PROCESSORS, carga);
+        imprimir_resultado(nome, BENCH_TRABALHO_ITENS, us_pool, ciclos_por_item_parede(us_pool, BENCH_TRABALHO_ITENS));
+        printf("{Cleber Dilenes - RM:89056} [BENCH] Pool %s: ganho %lu.%02lux, %lu roubos, trabalhador 0 %lu / trabalhador 1 %lu itens\n",
+               carga, ganho / 100, ganho % 100, total.roubados,
+               pool.trab[0].stats.processados, pool.trab[1].stats.processados);
+    }
+}
+
+// ==========================================
+// Faixas de prioridade com a faixa de volume sempre cheia: o produtor envia
+// volume bloqueando e um alarme a cada FX_ALARME_CADA itens; o consumidor leva
+// FX_CUSTO_CICLOS por item. Na FIFO única o alarme espera atrás da fila inteira;
+// com faixas (QueueSet + escalonador) espera no máximo o item em processamento.
+#define FX_VOLUME_CAP    16
+#define FX_URGENTE_CAP   8
+#define FX_ALARME_CADA   20
+#define FX_CUSTO_CICLOS  8000 // 50 us a 160 MHz
+
+typedef struct
+{
+    int politica;                  // -1: FIFO única; FAIXAS_ESTRITA / FAIXAS_PONDERADA
+    QueueHandle_t filas[FAIXAS_MAX];
+    QueueSetHandle_t conjunto;
+    faixas_t escalonador;
+    histograma_t latencia[FAIXAS_MAX];
+    SemaphoreHandle_t fim;
+} fx_ctx_t;
+
+#define FX_TOTAL (BENCH_FAIXAS_ITENS + BENCH_FAIXAS_ITENS / FX_ALARME_CADA)
+
+static void bench_fx_produtor(void *pv)
+{
+    fx_ctx_t *ctx = pv;
+
+    for(uint32_t i = 0; i < BENCH_FAIXAS_ITENS; i++)
+    {
+        fila_item_t item = { .seq = i, .faixa = FAIXA_VOLUME };
+        if(i % FX_ALARME_CADA == 0)
+        {
+            fila_item_t alarme = { .seq = i, .faixa = FAIXA_URGENTE, .t_producao = (uint32_t)esp_timer_get_time() };
+            xQueueSend(ctx->politica < 0 ? ctx->filas[FAIXA_VOLUME] : ctx->filas[FAIXA_URGENTE], &alarme, portMAX_DELAY);
+        }
+        item.t_producao = (uint32_t)esp_timer_get_time();
+        xQueueSend(ctx->filas[FAIXA_VOLUME], &item, portMAX_DELAY); // Bloqueia: volume sempre cheio
+    }
+    xSemaphoreGive(ctx->fim);
+    vTaskDelete(NULL);
+}
+
+static void bench_fx_consumidor(void *pv)
+{
+    fx_ctx_t *ctx = pv;
+    fila_item_t item;
+
+    for(uint32_t i = 0; i < FX_TOTAL; i++)
+    {
+        if(ctx->politica < 0)
+            xQueueReceive(ctx->filas[FAIXA_VOLUME], &item, portMAX_DELAY);
+        else
+        {
+            // Mesmo esquema do transporte: o conjunto conta os itens, o escalonador escolhe a faixa
+            xQueueSelectFromSet(ctx->conjunto, portMAX_DELAY);
+            bool pronta[FAIXAS_MAX];
+            for(uint32_t f = 0; f < FAIXAS_MAX; f++)
+                pronta[f] = uxQueueMessagesWaiting(ctx->filas[f]) > 0;
+            int f = faixas_escolher(&ctx->escalonador, pronta);
+            xQueueReceive(ctx->filas[f < 0 ? FAIXA_VOLUME : f], &item, 0);
+        }
+        histograma_registrar(&ctx->latencia[item.faixa], (uint32_t)esp_timer_get_time() - item.t_producao);
+        trabalho_carga(FX_CUSTO_CICLOS);
+    }
+    xSemaphoreGive(ctx->fim);
+    vTaskDelete(NULL);
+}
+
+static void bench_faixas_rodada(int politica)
+{
+    static fx_ctx_t ctx;
+    bool ok;
+
+    ctx = (fx_ctx_t){ .politica = politica };
+    for(uint32_t f = 0; f < FAIXAS_MAX; f++)
+        histograma_init(&ctx.latencia[f]);
+    faixas_init(&ctx.escalonador, FAIXAS_MAX, politica < 0 ? FAIXAS_ESTRITA : (uint32_t)politica);
+    ctx.fim = xSemaphoreCreateCounting(2, 0);
+
+    if(politica < 0)
+    {
+        ctx.filas[FAIXA_VOLUME] = xQueueCreate(FX_VOLUME_CAP + FX_URGENTE_CAP, sizeof(fila_item_t));
+        ok = ctx.filas[FAIXA_VOLUME] != NULL;
+    }
+    else
+    {
+        ctx.filas[FAIXA_VOLUME] = xQueueCreate(FX_VOLUME_CAP, sizeof(fila_item_t));
+        ctx.filas[FAIXA_URGENTE] = xQueueCreate(FX_URGENTE_CAP, sizeof(fila_item_t));
+        ctx.conjunto = xQueueCreateSet(FX_VOLUME_CAP + FX_URGENTE_CAP);
+        ok = ctx.filas[FAIXA_VOLUME] != NULL && ctx.filas[FAIXA_URGENTE] != NULL && ctx.conjunto != NULL &&
+             xQueueAddToSet(ctx.filas[FAIXA_VOLUME], ctx.conjunto) == pdPASS &&
+             xQueueAddToSet(ctx.filas[FAIXA_URGENTE], ctx.conjunto) == pdPASS;
+    }
+    if(!ok || ctx.fim == NULL)
+    {
+        printf("{Cleber Dilenes - RM:89056} [BENCH] Falha ao criar recursos do benchmark\n");
+        return;
+    }
+
+    xTaskCreatePinnedToCore(bench_fx_consumidor, "fx_cons", 4096, &ctx, 6, NULL, 1);
+    xTaskCreatePinnedToCore(bench_fx_produtor, "fx_prod", 4096, &ctx, 6, NULL, 0);
+    xSemaphoreTake(ctx.fim, portMAX_DELAY);
+    xSemaphoreTake(ctx.fim, portMAX_DELAY);
+
+    histograma_resumo_t urg, vol;
+    histograma_resumo(&ctx.latencia[FAIXA_URGENTE], &urg);
+    histograma_resumo(&ctx.latencia[FAIXA_VOLUME], &vol);
+    printf("{Cleber Dilenes - RM:89056} [BENCH] Faixas %-10s urgente p50 %5lu us p99 %5lu us máx %5lu us | "
+           "volume p50 %5lu us p99 %5lu us\n",
+           politica < 0 ? "FIFO única" : faixas_politica_nome(politica),
+           urg.p50, urg.p99, urg.maximo, vol.p50, vol.p99);
+
+    for(uint32_t f = 0; f < FAIXAS_MAX; f++)
+    {
+        if(ctx.filas[f] == NULL)
+            continue;
+        if(ctx.conjunto != NULL)
+            xQueueRemoveFromSet(ctx.filas[f], ctx.conjunto);
+        vQueueDelete(ctx.filas[f]);
+    }
+    if(ctx.conjunto != NULL)
+        vQueueDelete(ctx.conjunto);
+    vSemaphoreDelete(ctx.fim);
+}
+
+static void bench_faixas(void)
+{
+    bench_faixas_rodada(-1);
+    bench_faixas_rodada(FAIXAS_ESTRITA);
+    bench_faixas_rodada(FAIXAS_PONDERADA);
+}
+
+// ==========================================
+// Handoff de uma amostra da Task1 para a Task2 bloqueada (caso do fluxo
+// periódico), de TASK1_NUCLEO para TASK2_NUCLEO. Ida e volta pelo mesmo
+// mecanismo; o handoff é a metade da volta e o envio é só a chamada no produtor.
+//   fila:    xQueueSend / xQueueReceive de um fila_item_t (16 B)
+//   palavra: xTaskNotify(eSetValueWithoutOverwrite) / xTaskNotifyWait, só o valor
+//   caixa:   fila_item_t em uma caixa de um item + xTaskNotifyGive / ulTaskNotifyTake
+//            (caminho direto de FILA_TRANSPORTE_NOTIFICACAO)
+typedef enum { NT_FILA, NT_PALAVRA, NT_CAIXA } modo_nt_t;
+
+typedef struct
+{
+    fila_item_t item;
+    atomic_bool cheia;
+} nt_caixa_t;
+
+typedef struct
+{
+    modo_nt_t modo;
+    QueueHandle_t filas[2];   // [0] ida, [1] volta
+    nt_caixa_t caixas[2];
+    TaskHandle_t tarefas[2];  // Destino de cada sentido: [0] eco, [1] pingue
+    histograma_t handoff;     // Ciclos por handoff
+    histograma_t envio;       // Ciclos da chamada de envio
+    SemaphoreHandle_t fim;
+} nt_ctx_t;
+
+static void nt_enviar(nt_ctx_t *ctx, int sentido, const fila_item_t *item)
+{
+    switch(ctx->modo)
+    {
+    case NT_FILA:
+        xQueueSend(ctx->filas[sentido], item, portMAX_DELAY);
+        break;
+    case NT_PALAVRA:
+        xTaskNotify(ctx->tarefas[sentido], (uint32_t)item->valor, eSetValueWithoutOverwrite);
+        break;
+    case NT_CAIXA:
+        ctx->caixas[sentido].item = *item;
+        atomic_store_explicit(&ctx->caixas[sentido].cheia, true, memory_order_release);
+        xTaskNotifyGive(ctx->tarefas[sentido]);
+        break;
+    }
+}
+
+static void nt_receber(nt_ctx_t *ctx, int sentido, fila_item_t *item)
+{
+    uint32_t palavra;
+
+    switch(ctx->modo)
+    {
+    case NT_FILA:
+        xQueueReceive(ctx->filas[sentido], item, portMAX_DELAY);
+        break;
+    case NT_PALAVRA:
+        xTaskNotifyWait(0, 0, &palavra, portMAX_DELAY);
+        item->valor = (int)palavra;
+        break;
+    case NT_CAIXA:
+        while(!atomic_load_explicit(&ctx->caixas[sentido].cheia, memory_order_acquire))
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        *item = ctx->caixas[sentido].item;
+        atomic_store_explicit(&ctx->caixas[sentido].cheia, false, memory_order_release);
+        break;
+    }
+}
+
+static void bench_nt_eco(void *pv)
+{
+    nt_ctx_t *ctx = pv;
+    fila_item_t item;
+
+    for(uint32_t i = 0; i < BENCH_PINGUE; i++)
+    {
+        nt_receber(ctx, 0, &item);
+        nt_enviar(ctx, 1, &item);
+    }
+    xSemaphoreGive(ctx->fim);
+    vTaskDelete(NULL);
+}
+
+static void bench_nt_pingue(void *pv)
+{
+    nt_ctx_t *ctx = pv;
+    fila_item_t item = { .origem = ORIGEM_TASK1 };
+
+    ctx->tarefas[1] = xTaskGetCurrentTaskHandle(); // O eco só responde depois da primeira ida
+    for(uint32_t i = 0; i < BENCH_PINGUE; i++)
+    {
+        item.seq = i;
+        item.valor = (int)i;
+        uint32_t c0 = esp_cpu_get_cycle_count();
+        nt_enviar(ctx, 0, &item);
+        uint32_t c1 = esp_cpu_get_cycle_count();
+        nt_receber(ctx, 1, &item);
+        histograma_registrar(&ctx->envio, c1 - c0);
+        histograma_registrar(&ctx->handoff, (esp_cpu_get_cycle_count() - c0) / 2);
+    }
+    xSemaphoreGive(ctx->fim);
+    vTaskDelete(NULL);
+}
+
+// Retorna o p50 do handoff em ciclos (0 se a rodada não rodou)
+static uint32_t bench_nt_rodada(modo_nt_t modo, const char *nome)
+{
+    static nt_ctx_t ctx;
+    histograma_resumo_t handoff, envio;
+
+    ctx = (nt_ctx_t){ .modo = modo };
+    histograma_init(&ctx.handoff);
+    histograma_init(&ctx.envio);
+    ctx.fim = xSemaphoreCreateCounting(2, 0);
+    if(modo == NT_FILA)
+    {
+        ctx.filas[0] = xQueueCreate(1, sizeof(fila_item_t));
+        ctx.filas[1] = xQueueCreate(1, sizeof(fila_item_t));
+    }
+    if(ctx.fim == NULL || (modo == NT_FILA && (ctx.filas[0] == NULL || ctx.filas[1] == NULL)))
+    {
+        printf("{Cleber Dilenes - RM:89056} [BENCH] Falha ao criar recursos do benchmark\n");
+        return 0;
+    }
+
+    xTaskCreatePinnedToCore(bench_nt_eco, "nt_eco", 4096, &ctx, 6, &ctx.tarefas[0], TASK2_NUCLEO);
+    xTaskCreatePinnedToCore(bench_nt_pingue, "nt_pingue", 4096, &ctx, 6, NULL, TASK1_NUCLEO);
+    xSemaphoreTake(ctx.fim, portMAX_DELAY);
+    xSemaphoreTake(ctx.fim, portMAX_DELAY);
+
+    histograma_resumo(&ctx.handoff, &handoff);
+    histograma_resumo(&ctx.envio, &envio);
+    printf("{Cleber Dilenes - RM:89056} [BENCH] Handoff %-8s envio p50 %5lu ciclos | handoff p50 %5lu  p99 %5lu  "
+           "máx %6lu ciclos (%lu ns p50)\n",
+           nome, envio.p50, handoff.p50, handoff.p99, handoff.maximo,
+           handoff.p50 * 1000 / CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ);
+
+    for(int i = 0; i < 2; i++)
+    {
+        if(ctx.filas[i] != NULL)
+            vQueueDelete(ctx.filas[i]);
+    }
+    vSemaphoreDelete(ctx.fim);
+    return handoff.p50;
+}
+
+// Fila x notificação direta: decide FILA_TRANSPORTE quando o transporte usa filas FreeRTOS
+static void bench_notificacao(void)
+{
+    uint32_t fila = bench_nt_rodada(NT_FILA, "fila");
+    bench_nt_rodada(NT_PALAVRA, "palavra");
+    uint32_t caixa = bench_nt_rodada(NT_CAIXA, "caixa");
+
+    if(fila == 0 || caixa == 0)
+        return;
+    uint32_t permil = caixa * 1000 / fila;
+    printf("{Cleber Dilenes - RM:89056} [BENCH] Caixa + notificação: %lu.%lu%% dos ciclos da fila -> FILA_TRANSPORTE=%s\n",
+           permil / 10, permil % 10, caixa < fila ? "NOTIFICACAO" : "QUEUE");
+}
+
+// ==========================================
+void benchmarks_executar(void)
+{
+    printf("{Cleber Dilenes - RM:89056} [BENCH] Início dos benchmarks (%d itens)\n", BENCH_ITENS);
+
+    bench_custo_local();
+    bench_vazao(MODO_FILA, "fila xQueue (10 x int)", 0, 1);
+    bench_vazao(MODO_RING, "ring SPSC", 0, 1);
+    bench_vazao(MODO_RING_LOTE, "ring SPSC lote 8", 0, 1);
+    bench_afinidade();
+    bench_taxa_maxima();
+    bench_zero_copia();
+    bench_contrapressao();
+    bench_produtores();
+    bench_trabalhadores();
+    bench_faixas();
+    bench_notificacao();
+    bench_soak_pool();
+
+    printf("{Cleber Dilenes - RM:89056} [BENCH] Fim dos benchmarks\n");
+}
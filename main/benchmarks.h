@@ -0,0 +1,13 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Benchmarks de desempenho executados no boot (EXECUTAR_BENCHMARKS = 1)
+ */
+
+#pragma once
+
+// Executa todos os benchmarks e imprime os resultados no console.
+// Deve ser chamada em app_main antes da criação das tasks do sistema.
+void benchmarks_executar(void);
@@ -0,0 +1,66 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Implementação dos blocos de dados sem cópia
+ * A memória é um pool_blocos estático. Em um bloco livre a primeira palavra
+ * (estado) guarda o encadeamento da lista do pool, que nunca é igual a
+ * BLOCO_EM_USO; por isso o estado basta para detectar liberação dupla e para a
+ * varredura de vazamentos.
+ */
+
+#include <stdatomic.h>
+#include "esp_timer.h"
+#include "bloco_dados.h"
+
+#define BLOCO_EM_USO 0x55534F21u // "USO!"
+
+POOL_BLOCOS_MEMORIA(mem_blocos, sizeof(bloco_dados_t), BLOCO_QUANTIDADE);
+static pool_blocos_t pool_dados;
+static atomic_uint liberacoes_duplas;
+
+bool bloco_dados_init(void)
+{
+    return pool_blocos_init(&pool_dados, "dados", mem_blocos, sizeof(bloco_dados_t), BLOCO_QUANTIDADE);
+}
+
+bloco_dados_t *bloco_dados_alocar(void)
+{
+    bloco_dados_t *b = pool_blocos_alocar(&pool_dados);
+    if(b != NULL)
+    {
+        b->estado = BLOCO_EM_USO;
+        b->t_alocacao = (uint32_t)esp_timer_get_time();
+        b->tamanho = 0;
+    }
+    return b;
+}
+
+void bloco_dados_liberar(bloco_dados_t *b)
+{
+    if(b == NULL)
+        return;
+    if(b->estado != BLOCO_EM_USO)
+    {
+        atomic_fetch_add(&liberacoes_duplas, 1); // Já estava no pool: não devolve de novo
+        return;
+    }
+    pool_blocos_liberar(&pool_dados, b); // Sobrescreve o estado com o encadeamento da lista
+}
+
+void bloco_dados_estatisticas(bloco_dados_stats_t *stats)
+{
+    uint32_t agora = (uint32_t)esp_timer_get_time();
+
+    pool_blocos_estatisticas(&pool_dados, &stats->pool);
+    stats->liberacoes_duplas = atomic_load(&liberacoes_duplas);
+    stats->vazamentos = 0;
+
+    for(uint32_t i = 0; i < BLOCO_QUANTIDADE; i++)
+    {
+        const bloco_dados_t *b = (const bloco_dados_t *)(mem_blocos + i * POOL_TAMANHO_BLOCO(sizeof(bloco_dados_t)));
+        if(b->estado == BLOCO_EM_USO && agora - b->t_alocacao > BLOCO_IDADE_MAX_MS * 1000u)
+            stats->vazamentos++;
+    }
+}
@@ -0,0 +1,44 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Blocos de dados para transporte sem cópia (zero-copy)
+ * A Task1 preenche um bloco do pool e envia apenas o ponteiro pela fila;
+ * a Task2 processa o bloco no lugar e o devolve ao pool. Cada bloco guarda
+ * o estado e o instante da alocação para detectar liberação dupla e vazamentos.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "pool_blocos.h"
+#include "sistema_config.h"
+
+typedef struct
+{
+    uint32_t estado;      // BLOCO_EM_USO enquanto pertence a alguma task (1ª palavra)
+    uint32_t t_alocacao;  // esp_timer_get_time() na alocação (µs, 32 bits)
+    uint32_t tamanho;     // Bytes válidos em dados
+    uint8_t dados[BLOCO_PAYLOAD];
+} bloco_dados_t;
+
+typedef struct
+{
+    pool_blocos_stats_t pool;
+    uint32_t vazamentos;        // Blocos em uso há mais de BLOCO_IDADE_MAX_MS
+    uint32_t liberacoes_duplas; // Blocos devolvidos que já estavam livres
+} bloco_dados_stats_t;
+
+// Prepara o pool de blocos de dados.
+bool bloco_dados_init(void);
+
+// Retorna um bloco livre ou NULL se o pool estiver esgotado.
+bloco_dados_t *bloco_dados_alocar(void);
+
+// Devolve o bloco ao pool (detecta liberação dupla).
+void bloco_dados_liberar(bloco_dados_t *bloco);
+
+// Copia os contadores e conta os blocos vazados (percorre o pool, uso no logger).
+void bloco_dados_estatisticas(bloco_dados_stats_t *stats);
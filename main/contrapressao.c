@@ -0,0 +1,148 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Implementação das políticas de contrapressão
+ * A reserva é circular de tamanho 'capacidade' (0 nas políticas sem reserva).
+ * Enquanto houver retidos, um valor novo nunca passa à frente deles.
+ */
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "contrapressao.h"
+#include "log_async.h"
+
+static const char *const nomes[] = {
+    [CONTRAPRESSAO_DESCARTAR_NOVO]   = "descartar-novo",
+    [CONTRAPRESSAO_DESCARTAR_ANTIGO] = "descartar-antigo",
+    [CONTRAPRESSAO_BLOQUEAR]         = "bloquear-prazo",
+    [CONTRAPRESSAO_COALESCER]        = "coalescer",
+    [CONTRAPRESSAO_TRANSBORDO]       = "transbordo",
+};
+
+void contrapressao_init(contrapressao_t *cp, uint32_t politica, bool (*enviar)(const fila_item_t *item))
+{
+    cp->politica = politica;
+    cp->enviar = enviar;
+    cp->inicio = 0;
+    cp->n = 0;
+    cp->stats = (contrapressao_stats_t){0};
+
+    switch(politica)
+    {
+    case CONTRAPRESSAO_DESCARTAR_ANTIGO: cp->capacidade = CONTRAPRESSAO_JANELA; break;
+    case CONTRAPRESSAO_COALESCER:        cp->capacidade = 1; break;
+    case CONTRAPRESSAO_TRANSBORDO:       cp->capacidade = CONTRAPRESSAO_RESERVA; break;
+    default:                             cp->capacidade = 0; break;
+    }
+}
+
+// Valor perdido: devolve o bloco de dados ao pool
+static void descartar(contrapressao_t *cp, const fila_item_t *item)
+{
+#if FILA_ZERO_COPIA
+    bloco_dados_liberar(item->bloco);
+#endif
+    cp->stats.descartados++;
+}
+
+static void reter(contrapressao_t *cp, const fila_item_t *item)
+{
+    cp->reserva[(cp->inicio + cp->n) % cp->capacidade] = *item;
+    cp->n++;
+    if(cp->n > cp->stats.retidos_pico)
+        cp->stats.retidos_pico = cp->n;
+}
+
+static uint32_t bloquear(contrapressao_t *cp, const fila_item_t *item)
+{
+    int64_t inicio = esp_timer_get_time();
+    int64_t prazo = inicio + CONTRAPRESSAO_PRAZO_MS * 1000LL;
+    bool enviado;
+
+    do
+    {
+        vTaskDelay(1); // Libera o núcleo para o consumidor
+        enviado = cp->enviar(item);
+    } while(!enviado && esp_timer_get_time() < prazo);
+
+    uint32_t bloqueado = (uint32_t)(esp_timer_get_time() - inicio);
+    cp->stats.bloqueios++;
+    cp->stats.bloqueado_us += bloqueado;
+    if(bloqueado > cp->stats.bloqueio_max_us)
+        cp->stats.bloqueio_max_us = bloqueado;
+
+    if(!enviado)
+    {
+        descartar(cp, item); // Prazo vencido
+        return 1;
+    }
+    cp->stats.enviados++;
+    return 0;
+}
+
+uint32_t contrapressao_escoar(contrapressao_t *cp)
+{
+    while(cp->n > 0 && cp->enviar(&cp->reserva[cp->inicio]))
+    {
+        cp->inicio = (cp->inicio + 1) % cp->capacidade;
+        cp->n--;
+        cp->stats.enviados++;
+    }
+    return cp->n;
+}
+
+uint32_t contrapressao_enviar(contrapressao_t *cp, const fila_item_t *item)
+{
+    if(contrapressao_escoar(cp) == 0 && cp->enviar(item))
+    {
+        cp->stats.enviados++;
+        return 0;
+    }
+
+    switch(cp->politica)
+    {
+    case CONTRAPRESSAO_BLOQUEAR:
+        return bloquear(cp, item);
+
+    case CONTRAPRESSAO_DESCARTAR_ANTIGO:
+    case CONTRAPRESSAO_COALESCER:
+    case CONTRAPRESSAO_TRANSBORDO:
+        if(cp->n < cp->capacidade)
+        {
+            reter(cp, item);
+            return 0;
+        }
+        if(cp->politica == CONTRAPRESSAO_TRANSBORDO)
+            break; // Reserva cheia: perde o novo
+        descartar(cp, &cp->reserva[cp->inicio]); // Sai o mais antigo, entra o novo
+        cp->inicio = (cp->inicio + 1) % cp->capacidade;
+        cp->n--;
+        reter(cp, item);
+        return 1;
+
+    default:
+        break;
+    }
+
+    descartar(cp, item);
+    return 1;
+}
+
+const char *contrapressao_nome(uint32_t politica)
+{
+    return politica < sizeof(nomes) / sizeof(nomes[0]) ? nomes[politica] : "?";
+}
+
+void contrapressao_relatorio(const contrapressao_t *cp)
+{
+    const contrapressao_stats_t *s = &cp->stats;
+
+    log_printf("   - Contrapressão %s: %lu enviados, %lu descartados, %lu/%lu retidos (pico %lu)\n",
+               contrapressao_nome(cp->politica), s->enviados, s->descartados, cp->n, cp->capacidade,
+               s->retidos_pico);
+    log_printf("   - Contrapressão %s: %lu bloqueios (%llu ms, máx %lu us)\n",
+               contrapressao_nome(cp->politica), s->bloqueios, s->bloqueado_us / 1000, s->bloqueio_max_us);
+}
@@ -0,0 +1,59 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Políticas de contrapressão da Task1 (fila cheia)
+ * DESCARTAR_NOVO:   o valor novo é perdido (comportamento original)
+ * DESCARTAR_ANTIGO: mantém os CONTRAPRESSAO_JANELA valores mais recentes ainda
+ *                   não entregues, descartando o mais antigo deles
+ * BLOQUEAR:         espera a fila abrir espaço por até CONTRAPRESSAO_PRAZO_MS
+ * COALESCER:        guarda só o valor mais recente até a fila abrir espaço
+ * TRANSBORDO:       guarda até CONTRAPRESSAO_RESERVA valores em ordem em uma
+ *                   reserva secundária; com a reserva cheia o novo é perdido
+ * A reserva pertence ao produtor: a fila/ring nunca é esvaziada pelo lado da
+ * Task1, o que preserva o contrato SPSC do transporte. Um objeto por produtor.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "transporte.h"
+#include "sistema_config.h"
+
+typedef struct
+{
+    uint32_t enviados;        // Entregues ao transporte
+    uint32_t descartados;     // Valores perdidos pela política
+    uint32_t retidos_pico;    // Maior ocupação da reserva
+    uint32_t bloqueios;       // Vezes em que o produtor ficou bloqueado
+    uint32_t bloqueio_max_us;
+    uint64_t bloqueado_us;    // Tempo total bloqueado
+} contrapressao_stats_t;
+
+typedef struct
+{
+    uint32_t politica;                          // CONTRAPRESSAO_* (sistema_config.h)
+    bool (*enviar)(const fila_item_t *item);    // Envio sem bloqueio (transporte_enviar)
+    fila_item_t reserva[CONTRAPRESSAO_RESERVA];
+    uint32_t capacidade;                        // Posições da reserva usadas pela política
+    uint32_t inicio;                            // Mais antigo retido
+    uint32_t n;                                 // Retidos
+    contrapressao_stats_t stats;
+} contrapressao_t;
+
+// Configura a política e a função de envio não bloqueante.
+void contrapressao_init(contrapressao_t *cp, uint32_t politica, bool (*enviar)(const fila_item_t *item));
+
+// Entrega os retidos e o item (ou aplica a política). Retorna os valores perdidos.
+uint32_t contrapressao_enviar(contrapressao_t *cp, const fila_item_t *item);
+
+// Entrega à fila o que couber da reserva, em ordem. Retorna quantos ainda estão retidos.
+uint32_t contrapressao_escoar(contrapressao_t *cp);
+
+// Nome curto da política.
+const char *contrapressao_nome(uint32_t politica);
+
+// Loga os contadores da política (uso no logger).
+void contrapressao_relatorio(const contrapressao_t *cp);
@@ -0,0 +1,95 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Implementação do controle de taxa
+ * A vazão do consumidor é suavizada (peso 1/4 para a janela nova): com períodos
+ * de 10 ms cada janela vê só 0 ou 1 item entregue.
+ */
+
+#include "controle_taxa.h"
+#include "log_async.h"
+
+void controle_taxa_init(controle_taxa_t *ct, uint32_t periodo_min_ms, uint32_t periodo_max_ms,
+                        uint32_t capacidade, uint32_t alvo_pct)
+{
+    uint32_t alvo = capacidade * alvo_pct / 100;
+
+    *ct = (controle_taxa_t){
+        .periodo_min_ms = periodo_min_ms,
+        .periodo_max_ms = periodo_max_ms,
+        .capacidade = capacidade,
+        .alvo = alvo > 0 ? alvo : 1,
+        .periodo_ms = periodo_max_ms,
+        .periodo_menor_ms = periodo_max_ms,
+    };
+}
+
+// Média móvel da vazão entregue desde a última atualização (mili-itens/s)
+static void medir_vazao(controle_taxa_t *ct, uint32_t consumidos, int64_t agora_us)
+{
+    if(ct->atualizacao_us != 0 && agora_us > ct->atualizacao_us)
+    {
+        uint64_t janela_mhz = (uint64_t)(consumidos - ct->consumidos) * 1000000000ULL /
+                              (uint64_t)(agora_us - ct->atualizacao_us);
+        int64_t erro = (int64_t)janela_mhz - (int64_t)ct->vazao_mhz;
+        ct->vazao_mhz = (uint32_t)((int64_t)ct->vazao_mhz + erro / 4);
+    }
+    ct->consumidos = consumidos;
+    ct->atualizacao_us = agora_us;
+}
+
+uint32_t controle_taxa_atualizar(controle_taxa_t *ct, uint32_t ocupacao, uint32_t consumidos, int64_t agora_us)
+{
+    uint32_t periodo = ct->periodo_ms;
+
+    medir_vazao(ct, consumidos, agora_us);
+    ct->ocupacao = ocupacao;
+    if(ocupacao > ct->ocupacao_pico)
+        ct->ocupacao_pico = ocupacao;
+
+    if(ocupacao >= ct->alvo)
+    {
+        // Freia: dobra o período e não produz mais rápido do que o consumidor drena
+        periodo *= 2;
+        if(ct->vazao_mhz > 0 && 1000000u / ct->vazao_mhz > periodo)
+            periodo = 1000000u / ct->vazao_mhz;
+        ct->frenagens++;
+    }
+    else if(ocupacao * 2 < ct->alvo)
+    {
+        // Folga: acelera 1/8 do período (pelo menos 1 ms)
+        uint32_t passo = periodo / 8;
+        periodo -= passo > 0 ? passo : 1;
+        ct->aceleracoes++;
+    }
+    else
+    {
+        ct->manutencoes++;
+    }
+
+    if(periodo < ct->periodo_min_ms)
+        periodo = ct->periodo_min_ms;
+    if(periodo > ct->periodo_max_ms)
+        periodo = ct->periodo_max_ms;
+
+    ct->periodo_ms = periodo;
+    if(periodo < ct->periodo_menor_ms)
+        ct->periodo_menor_ms = periodo;
+    return periodo;
+}
+
+void controle_taxa_relatorio(const controle_taxa_t *ct)
+{
+    uint32_t periodo = ct->periodo_ms;
+    uint32_t taxa_dhz = periodo > 0 ? 10000u / periodo : 0; // Décimos de Hz
+    uint32_t vazao = ct->vazao_mhz;
+
+    log_printf("   - Controle de taxa: T=%lu ms (%lu.%lu Hz, menor %lu ms)\n",
+               periodo, taxa_dhz / 10, taxa_dhz % 10, ct->periodo_menor_ms);
+    log_printf("   - Controle de taxa: ocupação %lu/%lu (alvo %lu, pico %lu), consumo %lu.%lu itens/s\n",
+               ct->ocupacao, ct->capacidade, ct->alvo, ct->ocupacao_pico, vazao / 1000, (vazao % 1000) / 100);
+    log_printf("   - Decisões do controle: acelerou %lu, freou %lu, manteve %lu\n",
+               ct->aceleracoes, ct->frenagens, ct->manutencoes);
+}
@@ -0,0 +1,53 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Controle de taxa em malha fechada do produtor periódico
+ * A cada ativação o produtor informa a ocupação observada e o contador de itens
+ * entregues pelo consumidor; o controle devolve o próximo período:
+ *   ocupação >= alvo:     freia (período x2, e nunca mais rápido que a vazão
+ *                         medida do consumidor)
+ *   ocupação <  alvo / 2: acelera (período - 1/8)
+ *   entre os dois:        mantém
+ * Aumento multiplicativo do período e redução gradual (AIMD): a fila volta
+ * depressa para baixo do alvo e a taxa sobe devagar até o limite do consumidor.
+ * Usado por uma única task produtora; a Task4 apenas lê.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+typedef struct
+{
+    // Configuração
+    uint32_t periodo_min_ms;
+    uint32_t periodo_max_ms;
+    uint32_t capacidade;      // Posições observadas
+    uint32_t alvo;            // Ocupação alvo (itens)
+
+    // Estado
+    uint32_t periodo_ms;      // Período decidido
+    uint32_t ocupacao;        // Última ocupação informada
+    uint32_t vazao_mhz;       // Vazão do consumidor (mili-itens/s, média móvel)
+    uint32_t consumidos;      // Contador do consumidor na última atualização
+    int64_t atualizacao_us;   // 0 = ainda sem referência de vazão
+
+    // Decisões (escritas só pela task dona)
+    uint32_t aceleracoes;
+    uint32_t frenagens;
+    uint32_t manutencoes;
+    uint32_t ocupacao_pico;
+    uint32_t periodo_menor_ms; // Menor período já decidido
+} controle_taxa_t;
+
+// Configura os limites do período e o alvo (% de 'capacidade'). Começa em periodo_max_ms.
+void controle_taxa_init(controle_taxa_t *ct, uint32_t periodo_min_ms, uint32_t periodo_max_ms,
+                        uint32_t capacidade, uint32_t alvo_pct);
+
+// Registra a ocupação e o total entregue pelo consumidor. Retorna o próximo período (ms).
+uint32_t controle_taxa_atualizar(controle_taxa_t *ct, uint32_t ocupacao, uint32_t consumidos, int64_t agora_us);
+
+// Loga o estado e as decisões do controle (uso no logger).
+void controle_taxa_relatorio(const controle_taxa_t *ct);
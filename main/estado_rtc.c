@@ -0,0 +1,134 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Implementação do estado preservado em memória RTC
+ * O contador da Task1 é salvo a cada envio, então sobrevive a qualquer reset
+ * (inclusive panic e WDT). A fila só é copiada no esp_restart(), por um
+ * handler de desligamento: em um panic os itens em trânsito se perdem, mas a
+ * lacuna fica visível na sequência. Os ponteiros de bloco (FILA_ZERO_COPIA)
+ * não valem após o reset e os itens reenviados seguem só com o cabeçalho.
+ * O carimbo de produção é do esp_timer do boot anterior: o reenvio o refaz.
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_attr.h"
+#include "esp_system.h"
+#include "esp_rom_crc.h"
+#include "esp_timer.h"
+#include "estado_rtc.h"
+#include "recuperacao.h"
+#include "transporte.h"
+#include "sistema_config.h"
+
+#define ESTADO_RTC_MAGICA 0x52544331u // "RTC1"; mudar ao alterar o layout
+
+typedef struct
+{
+    uint32_t magica;
+    uint32_t reinicios;          // Boots quentes consecutivos
+    int32_t valor;               // Próximo valor da Task1
+    uint32_t seq;                // Próxima sequência da Task1
+    uint32_t acoes[REC_NIVEIS];  // Ações de recuperação por nível
+    int32_t nivel;               // Incidente em andamento no reset (-1: nenhum)
+    uint32_t desde_ms;           // Da última ação de recuperação até o reset
+    uint32_t n_pendentes;
+    fila_item_t pendentes[ESTADO_RTC_PENDENTES];
+    uint32_t crc;                // esp_rom_crc32_le dos campos acima
+} estado_rtc_t;
+
+static RTC_NOINIT_ATTR estado_rtc_t estado;
+static portMUX_TYPE trava = portMUX_INITIALIZER_UNLOCKED;
+
+static uint32_t calcular_crc(void)
+{
+    return esp_rom_crc32_le(0, (const uint8_t *)&estado, offsetof(estado_rtc_t, crc));
+}
+
+// Chamado pelo esp_restart(): copia a fila e o estado da recuperação
+static void ao_reiniciar(void)
+{
+    static fila_item_t itens[ESTADO_RTC_PENDENTES]; // Fora da pilha de quem chamou esp_restart
+    uint32_t n = transporte_receber_lote(itens, ESTADO_RTC_PENDENTES);
+    uint32_t acoes[REC_NIVEIS];
+    int nivel;
+    uint32_t desde_ms;
+
+    recuperacao_exportar(acoes, &nivel, &desde_ms);
+
+    taskENTER_CRITICAL(&trava);
+    memcpy(estado.pendentes, itens, n * sizeof(fila_item_t));
+    estado.n_pendentes = n;
+    memcpy(estado.acoes, acoes, sizeof(acoes));
+    estado.nivel = nivel;
+    estado.desde_ms = desde_ms;
+    estado.crc = calcular_crc();
+    taskEXIT_CRITICAL(&trava);
+}
+
+bool estado_rtc_init(void)
+{
+    bool quente = esp_reset_reason() != ESP_RST_POWERON &&
+                  estado.magica == ESTADO_RTC_MAGICA && estado.crc == calcular_crc() &&
+                  estado.n_pendentes <= ESTADO_RTC_PENDENTES;
+
+    if(quente)
+    {
+        estado.reinicios++;
+        recuperacao_importar(estado.acoes, estado.nivel, estado.desde_ms);
+    }
+    else
+    {
+        memset(&estado, 0, sizeof(estado));
+        estado.magica = ESTADO_RTC_MAGICA;
+        estado.nivel = -1;
+    }
+    estado.crc = calcular_crc();
+
+    esp_register_shutdown_handler(ao_reiniciar);
+    return quente;
+}
+
+uint32_t estado_rtc_reinicios(void)
+{
+    return estado.reinicios;
+}
+
+uint32_t estado_rtc_reenviar(void)
+{
+    uint32_t reenviados = 0;
+
+    for(uint32_t i = 0; i < estado.n_pendentes; i++)
+    {
+        fila_item_t item = estado.pendentes[i];
+        item.t_producao = (uint32_t)esp_timer_get_time(); // Senão a latência daria a volta nos 32 bits
+#if FILA_ZERO_COPIA
+        item.bloco = NULL;
+#endif
+        reenviados += transporte_enviar(&item);
+    }
+
+    taskENTER_CRITICAL(&trava);
+    estado.n_pendentes = 0;
+    estado.crc = calcular_crc();
+    taskEXIT_CRITICAL(&trava);
+    return reenviados;
+}
+
+void estado_rtc_produtor(int *valor, uint32_t *seq)
+{
+    *valor = estado.valor;
+    *seq = estado.seq;
+}
+
+void estado_rtc_salvar_produtor(int valor, uint32_t seq)
+{
+    taskENTER_CRITICAL(&trava);
+    estado.valor = valor;
+    estado.seq = seq;
+    estado.crc = calcular_crc();
+    taskEXIT_CRITICAL(&trava);
+}
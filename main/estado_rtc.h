@@ -0,0 +1,32 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Estado do pipeline preservado entre resets (RTC_NOINIT_ATTR)
+ * Guarda o contador e a sequência da Task1, os itens ainda não entregues da
+ * fila e o estado do gerente de recuperação, protegidos por CRC32. Após um
+ * reset (boot quente) a Task1 continua da próxima sequência e os itens salvos
+ * são reenviados; em um boot frio (energização ou CRC inválido) tudo começa do zero.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Valida a memória RTC, restaura o gerente de recuperação e registra o salvamento
+// da fila no esp_restart(). Retorna true em boot quente.
+bool estado_rtc_init(void);
+
+// Boots quentes consecutivos desde o último boot frio.
+uint32_t estado_rtc_reinicios(void);
+
+// Reenvia ao transporte os itens salvos antes do reset. Retorna quantos foram reenviados.
+uint32_t estado_rtc_reenviar(void);
+
+// Contador e sequência da Task1 (zero em boot frio).
+void estado_rtc_produtor(int *valor, uint32_t *seq);
+
+// Atualiza o contador e a sequência da Task1 (a cada envio).
+void estado_rtc_salvar_produtor(int valor, uint32_t seq);
@@ -0,0 +1,39 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Implementação do barramento de eventos por contagem
+ * A leitura não é um instantâneo coerente entre eventos (cada contador é lido
+ * separadamente); um evento sinalizado durante a leitura aparece no ciclo seguinte.
+ */
+
+#include "eventos.h"
+
+eventos_nucleo_t eventos_por_nucleo[portNUM_PROCESSORS];
+
+void eventos_ler(uint32_t total[EVT_NUM])
+{
+    for(int ev = 0; ev < EVT_NUM; ev++)
+    {
+        total[ev] = 0;
+        for(int n = 0; n < portNUM_PROCESSORS; n++)
+            total[ev] += atomic_load_explicit(&eventos_por_nucleo[n].contagem[ev], memory_order_relaxed);
+    }
+}
+
+const char *evento_nome(evento_t ev)
+{
+    static const char *const nomes[EVT_NUM] = {
+        [EVT_TASK1_OK] = "Task1 OK",
+        [EVT_TASK1_FALHA] = "Task1 falhou no envio",
+        [EVT_TASK2_OK] = "Task2 OK",
+        [EVT_TASK2_TIMEOUT] = "Task2 em timeout leve",
+        [EVT_TASK2_RESET] = "Task2 resetou a fila",
+        [EVT_TASK2_RESTART] = "Task2 reiniciou o sistema",
+        [EVT_TASK1_RECRIADA] = "Task2 recriou a Task1",
+        [EVT_PRODUTOR_OK] = "Produtores OK",
+        [EVT_PRODUTOR_FALHA] = "Produtores falharam no envio",
+    };
+    return (ev >= 0 && ev < EVT_NUM) ? nomes[ev] : "?";
+}
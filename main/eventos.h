@@ -0,0 +1,52 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Barramento de eventos por contagem
+ * Cada evento incrementa um contador atômico no bloco do núcleo em execução;
+ * o supervisor soma os núcleos e compara com a leitura anterior. Ao contrário
+ * dos bits do EventGroup, nenhum evento se perde entre duas leituras e o
+ * sinal custa um único incremento, sem seção crítica (também vale em ISR).
+ */
+
+#pragma once
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+
+typedef enum
+{
+    EVT_TASK1_OK,       // Item enviado pela Task1
+    EVT_TASK1_FALHA,    // Envio perdido (fila cheia / falha injetada)
+    EVT_TASK2_OK,       // Item recebido pela Task2
+    EVT_TASK2_TIMEOUT,  // Recuperação leve
+    EVT_TASK2_RESET,    // Fila descartada
+    EVT_TASK2_RESTART,  // Reinício do chip
+    EVT_TASK1_RECRIADA, // Task1 recriada pela Task2
+    EVT_PRODUTOR_OK,    // Item enviado por um produtor extra
+    EVT_PRODUTOR_FALHA, // Shard de um produtor extra cheio
+    EVT_NUM
+} evento_t;
+
+// Contadores de um núcleo, em linha de cache própria
+typedef struct
+{
+    _Alignas(32) atomic_uint contagem[EVT_NUM];
+} eventos_nucleo_t;
+
+extern eventos_nucleo_t eventos_por_nucleo[portNUM_PROCESSORS];
+
+// Sinaliza um evento. Se a task migrar entre a leitura do núcleo e o
+// incremento, a contagem cai no outro bloco, mas continua atômica.
+static inline void evento_sinalizar(evento_t ev)
+{
+    atomic_fetch_add_explicit(&eventos_por_nucleo[xPortGetCoreID()].contagem[ev], 1, memory_order_relaxed);
+}
+
+// Soma dos núcleos desde o boot (contadores de 32 bits: use a diferença).
+void eventos_ler(uint32_t total[EVT_NUM]);
+
+// Texto curto do evento para os relatórios.
+const char *evento_nome(evento_t ev);
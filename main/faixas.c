@@ -0,0 +1,66 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Implementação do escalonador de faixas
+ * Ponderado: a faixa da vez entrega até seu peso em itens seguidos; vazia ou
+ * sem crédito, a vez passa à próxima (da mais urgente para o volume).
+ */
+
+#include "faixas.h"
+
+void faixas_init(faixas_t *f, uint32_t n, uint32_t politica)
+{
+    *f = (faixas_t){ .politica = politica, .n = n < FAIXAS_MAX ? n : FAIXAS_MAX };
+    for(uint32_t i = 0; i < FAIXAS_MAX; i++)
+        f->pesos[i] = 1;
+    f->pesos[FAIXA_URGENTE] = FAIXA_PESO_URGENTE;
+    f->atual = f->n - 1;
+    f->credito = f->pesos[f->atual];
+}
+
+int faixas_escolher(faixas_t *f, const bool pronta[FAIXAS_MAX])
+{
+    int escolhida = -1;
+
+    if(f->politica == FAIXAS_ESTRITA || f->n == 1)
+    {
+        for(int i = (int)f->n - 1; i >= 0 && escolhida < 0; i--)
+        {
+            if(pronta[i])
+                escolhida = i;
+        }
+    }
+    else
+    {
+        // Uma volta completa (n + 1 passos) basta para achar qualquer faixa pronta
+        for(uint32_t passo = 0; passo <= f->n && escolhida < 0; passo++)
+        {
+            if(pronta[f->atual] && f->credito > 0)
+            {
+                f->credito--;
+                escolhida = f->atual;
+            }
+            else
+            {
+                f->atual = f->atual == 0 ? f->n - 1 : f->atual - 1;
+                f->credito = f->pesos[f->atual];
+            }
+        }
+    }
+
+    if(escolhida >= 0)
+        f->atendidos[escolhida]++;
+    return escolhida;
+}
+
+const char *faixas_nome(uint32_t faixa)
+{
+    return faixa == FAIXA_URGENTE ? "urgente" : "volume";
+}
+
+const char *faixas_politica_nome(uint32_t politica)
+{
+    return politica == FAIXAS_PONDERADA ? "ponderada" : "estrita";
+}
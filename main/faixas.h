@@ -0,0 +1,39 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Escalonador das faixas de prioridade do consumidor
+ * Decide de qual faixa sai o próximo item, dado quais faixas têm dados:
+ * estrito (sempre a mais urgente) ou ponderado (rodízio com peso por faixa,
+ * que garante vazão mínima ao volume). Usado só pelo consumidor.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sistema_config.h"
+
+#define FAIXAS_MAX 2
+
+typedef struct
+{
+    uint32_t politica;             // FAIXAS_ESTRITA / FAIXAS_PONDERADA
+    uint32_t pesos[FAIXAS_MAX];    // Itens seguidos por vez no ponderado
+    uint32_t n;                    // Faixas em uso
+    uint32_t atual;                // Faixa da vez no ponderado
+    uint32_t credito;              // Itens que a faixa da vez ainda pode entregar
+    uint32_t atendidos[FAIXAS_MAX];
+} faixas_t;
+
+// Prepara o escalonador de n faixas (FAIXA_VOLUME = 0 ... FAIXA_URGENTE).
+void faixas_init(faixas_t *f, uint32_t n, uint32_t politica);
+
+// Faixa do próximo item entre as prontas (pronta[faixa] = tem dados), ou -1.
+// A faixa escolhida é contabilizada como atendida.
+int faixas_escolher(faixas_t *f, const bool pronta[FAIXAS_MAX]);
+
+// Nome curto da faixa / da política.
+const char *faixas_nome(uint32_t faixa);
+const char *faixas_politica_nome(uint32_t politica);
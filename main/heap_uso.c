@@ -0,0 +1,112 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Implementação da contagem de alocações e da telemetria do heap
+ * Os ganchos rodam dentro do alocador (possivelmente com o cache desligado):
+ * ficam em IRAM e só fazem um incremento atômico.
+ * Tendência: média móvel exponencial (peso 1/4) da variação do maior bloco por
+ * relatório, extrapolada por HEAP_TENDENCIA_CICLOS relatórios.
+ */
+
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "sdkconfig.h"
+#include "heap_uso.h"
+#include "log_async.h"
+#include "sistema_config.h"
+
+#if !CONFIG_HEAP_USE_HOOKS
+#error "heap_uso.c precisa de CONFIG_HEAP_USE_HOOKS=y"
+#endif
+
+static atomic_uint alocacoes;
+static atomic_uint liberacoes;
+
+void IRAM_ATTR esp_heap_trace_alloc_hook(void *ptr, size_t tamanho, uint32_t caps)
+{
+    atomic_fetch_add_explicit(&alocacoes, 1, memory_order_relaxed);
+}
+
+void IRAM_ATTR esp_heap_trace_free_hook(void *ptr)
+{
+    atomic_fetch_add_explicit(&liberacoes, 1, memory_order_relaxed);
+}
+
+void heap_uso_contagem(heap_uso_contagem_t *c)
+{
+    c->alocacoes = atomic_load_explicit(&alocacoes, memory_order_relaxed);
+    c->liberacoes = atomic_load_explicit(&liberacoes, memory_order_relaxed);
+}
+
+// ==========================================
+// Telemetria por capacidade
+typedef struct
+{
+    const char *nome;
+    uint32_t caps;
+    bool iniciado;
+    uint32_t maior_anterior;
+    int32_t variacao_media; // Bytes por relatório (negativo: encolhendo)
+} regiao_t;
+
+static regiao_t regioes[] = {
+    { .nome = "interna",   .caps = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT },
+    { .nome = "DMA",       .caps = MALLOC_CAP_DMA },
+    { .nome = "IRAM 8bit", .caps = MALLOC_CAP_IRAM_8BIT },
+};
+
+static void tendencia(regiao_t *r, uint32_t maior)
+{
+    if(!r->iniciado)
+    {
+        r->iniciado = true;
+        r->maior_anterior = maior;
+        return;
+    }
+
+    int32_t variacao = (int32_t)maior - (int32_t)r->maior_anterior;
+    r->variacao_media += (variacao - r->variacao_media) / 4;
+    r->maior_anterior = maior;
+
+    int64_t previsto = (int64_t)maior + (int64_t)r->variacao_media * HEAP_TENDENCIA_CICLOS;
+    if(maior < HEAP_BLOCO_NECESSARIO)
+    {
+        log_printf("{Cleber Dilenes - RM:89056} [HEAP] Alerta: %s maior bloco %lu B < %d B necessários\n",
+                   r->nome, maior, HEAP_BLOCO_NECESSARIO);
+    }
+    else if(r->variacao_media < 0 && previsto < HEAP_BLOCO_NECESSARIO)
+    {
+        // Duas linhas (LOG_TAM_LINHA): a previsão vem primeiro para nunca ser cortada
+        log_printf("{Cleber Dilenes - RM:89056} [HEAP] Alerta: %s abaixo de %d B em ~%ld ciclos\n",
+                   r->nome, HEAP_BLOCO_NECESSARIO,
+                   (long)((maior - HEAP_BLOCO_NECESSARIO) / (uint32_t)-r->variacao_media));
+        log_printf("{Cleber Dilenes - RM:89056} [HEAP] Alerta: %s maior bloco %lu B, caindo %ld B/ciclo\n",
+                   r->nome, maior, (long)-r->variacao_media);
+    }
+}
+
+void heap_uso_relatorio(void)
+{
+    for(uint32_t i = 0; i < sizeof(regioes) / sizeof(regioes[0]); i++)
+    {
+        regiao_t *r = &regioes[i];
+        size_t total = heap_caps_get_total_size(r->caps);
+        if(total == 0)
+            continue; // Região não habilitada no sdkconfig
+
+        multi_heap_info_t info;
+        heap_caps_get_info(&info, r->caps);
+        uint32_t frag = info.total_free_bytes > 0 ?
+                        (uint32_t)(1000 - (uint64_t)info.largest_free_block * 1000 / info.total_free_bytes) : 0;
+
+        log_printf("   - Heap %s: livre %u/%u, maior bloco %u\n",
+                   r->nome, info.total_free_bytes, total, info.largest_free_block);
+        log_printf("   - Heap %s: mínimo %u, %u blocos alocados, fragmentação %lu.%lu%%\n",
+                   r->nome, info.minimum_free_bytes, info.allocated_blocks, frag / 10, frag % 10);
+        tendencia(r, info.largest_free_block);
+    }
+}
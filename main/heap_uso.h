@@ -0,0 +1,30 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Contagem de alocações e telemetria do heap
+ * Usa os ganchos do heap do ESP-IDF (CONFIG_HEAP_USE_HOOKS), chamados em toda
+ * alocação e liberação de qualquer task ou núcleo. O logger compara os
+ * contadores entre relatórios para provar que o regime permanente não aloca.
+ * A telemetria separa as regiões por capacidade (interna, DMA, IRAM 8 bits) e
+ * acompanha a tendência do maior bloco livre de cada uma.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+typedef struct
+{
+    uint32_t alocacoes;
+    uint32_t liberacoes;
+} heap_uso_contagem_t;
+
+// Copia os contadores acumulados desde o boot.
+void heap_uso_contagem(heap_uso_contagem_t *contagem);
+
+// Loga, por região, livre/total, maior bloco, mínimo histórico, blocos alocados
+// e fragmentação; avisa se o maior bloco caminha para menos de HEAP_BLOCO_NECESSARIO
+// (uso no logger, uma vez por ciclo: a tendência é medida por relatório).
+void heap_uso_relatorio(void);
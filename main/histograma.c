@@ -0,0 +1,84 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Implementação do histograma log-linear
+ * Valores < HIST_SUB têm faixa exata; acima disso a faixa é escolhida pelo bit
+ * mais significativo (oitava) e pelos HIST_SUB_BITS bits seguintes.
+ */
+
+#include "histograma.h"
+
+static inline uint32_t faixa_de(uint32_t valor)
+{
+    if(valor < HIST_SUB)
+        return valor;
+
+    uint32_t msb = 31 - __builtin_clz(valor); // Oitava do valor
+    uint32_t sub = (valor >> (msb - HIST_SUB_BITS)) - HIST_SUB;
+    return HIST_SUB + (msb - HIST_SUB_BITS) * HIST_SUB + sub;
+}
+
+// Maior valor que cai na faixa
+static inline uint32_t limite_superior(uint32_t faixa)
+{
+    if(faixa < HIST_SUB)
+        return faixa;
+
+    uint32_t oitava = (faixa - HIST_SUB) / HIST_SUB;
+    uint32_t sub = (faixa - HIST_SUB) % HIST_SUB;
+    uint64_t inicio = (uint64_t)(HIST_SUB + sub) << oitava;
+    return (uint32_t)(inicio + (1ULL << oitava) - 1);
+}
+
+void histograma_init(histograma_t *h)
+{
+    for(uint32_t i = 0; i < HIST_FAIXAS; i++)
+        atomic_init(&h->contagem[i], 0);
+    atomic_init(&h->total, 0);
+    atomic_init(&h->maximo, 0);
+}
+
+void histograma_registrar(histograma_t *h, uint32_t valor)
+{
+    atomic_fetch_add_explicit(&h->contagem[faixa_de(valor)], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&h->total, 1, memory_order_relaxed);
+
+    uint32_t maximo = atomic_load_explicit(&h->maximo, memory_order_relaxed);
+    while(valor > maximo &&
+          !atomic_compare_exchange_weak_explicit(&h->maximo, &maximo, valor,
+                                                 memory_order_relaxed, memory_order_relaxed))
+        ;
+}
+
+uint32_t histograma_percentil(const histograma_t *h, uint32_t permil)
+{
+    uint32_t total = atomic_load_explicit(&h->total, memory_order_relaxed);
+    uint32_t maximo = atomic_load_explicit(&h->maximo, memory_order_relaxed);
+    if(total == 0)
+        return 0;
+
+    uint64_t alvo = ((uint64_t)total * permil + 999) / 1000; // Posição da amostra procurada
+    uint64_t acumulado = 0;
+
+    for(uint32_t i = 0; i < HIST_FAIXAS; i++)
+    {
+        acumulado += atomic_load_explicit(&h->contagem[i], memory_order_relaxed);
+        if(acumulado >= alvo)
+        {
+            uint32_t limite = limite_superior(i);
+            return limite < maximo ? limite : maximo;
+        }
+    }
+    return maximo;
+}
+
+void histograma_resumo(const histograma_t *h, histograma_resumo_t *resumo)
+{
+    resumo->total = atomic_load_explicit(&h->total, memory_order_relaxed);
+    resumo->p50 = histograma_percentil(h, 500);
+    resumo->p99 = histograma_percentil(h, 990);
+    resumo->p999 = histograma_percentil(h, 999);
+    resumo->maximo = atomic_load_explicit(&h->maximo, memory_order_relaxed);
+}
@@ -0,0 +1,49 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Histograma log-linear (estilo HDR) de memória fixa
+ * Cada oitava [2^p, 2^(p+1)) é dividida em HIST_SUB faixas iguais, o que dá
+ * erro relativo máximo de 1/HIST_SUB (~6%) em qualquer escala de 0 a 2^32.
+ * O registro é lock-free (incrementos atômicos) e pode ser feito de qualquer
+ * núcleo; as consultas leem os contadores sem parar os produtores.
+ */
+
+#pragma once
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+#define HIST_SUB_BITS 4
+#define HIST_SUB      (1u << HIST_SUB_BITS)
+#define HIST_FAIXAS   (HIST_SUB + (32 - HIST_SUB_BITS) * HIST_SUB)
+
+typedef struct
+{
+    atomic_uint contagem[HIST_FAIXAS];
+    atomic_uint total;
+    atomic_uint maximo;
+} histograma_t;
+
+typedef struct
+{
+    uint32_t total;
+    uint32_t p50;
+    uint32_t p99;
+    uint32_t p999;
+    uint32_t maximo;
+} histograma_resumo_t;
+
+// Zera todos os contadores (não usar com produtores ativos).
+void histograma_init(histograma_t *h);
+
+// Registra um valor (lock-free, O(1)).
+void histograma_registrar(histograma_t *h, uint32_t valor);
+
+// Valor abaixo do qual estão 'permil' milésimos das amostras (990 = p99, 999 = p99.9).
+// Retorna o limite superior da faixa encontrada, limitado ao máximo observado.
+uint32_t histograma_percentil(const histograma_t *h, uint32_t permil);
+
+// Preenche total, p50, p99, p99.9 e máximo.
+void histograma_resumo(const histograma_t *h, histograma_resumo_t *resumo);
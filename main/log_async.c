@@ -0,0 +1,201 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Implementação do log assíncrono
+ * Ring limitado de vários produtores e um consumidor com número de sequência
+ * por slot: o produtor reserva o slot com CAS no head, escreve o texto e
+ * publica o slot; a task de drenagem lê os slots em ordem.
+ * Em LOG_MODO_BINARIO o slot guarda o registro binário (log_binario.c) em vez do texto.
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "log_async.h"
+#include "log_binario.h"
+#include "sistema_config.h"
+
+#if (LOG_CAPACIDADE & (LOG_CAPACIDADE - 1)) != 0
+#error "LOG_CAPACIDADE precisa ser potência de 2"
+#endif
+
+typedef struct
+{
+    atomic_uint seq;          // == posição: livre; == posição + 1: pronto para drenar
+    uint16_t tamanho;
+    char texto[LOG_TAM_LINHA]; // Texto ou registro binário, conforme LOG_MODO
+} log_slot_t;
+
+static log_slot_t slots[LOG_CAPACIDADE];
+static atomic_uint head;      // Próxima posição a reservar (produtores)
+static uint32_t tail;         // Próxima posição a drenar (somente a task de drenagem)
+
+static atomic_uint enviadas;
+static atomic_uint escritas;
+static atomic_uint descartadas;
+
+// ==========================================
+// Formata uma mensagem no buffer do slot; retorna o tamanho (0 = nada a escrever)
+static uint16_t formatar(char *destino, const char *fmt, va_list args)
+{
+#if LOG_MODO == LOG_MODO_BINARIO
+    return log_binario_codificar((uint8_t *)destino, LOG_TAM_LINHA, fmt, args);
+#else
+    int n = vsnprintf(destino, LOG_TAM_LINHA, fmt, args);
+
+    if(n < 0)
+        n = 0;
+    if(n >= LOG_TAM_LINHA)
+    {
+        n = LOG_TAM_LINHA - 1; // Linha truncada: garante a quebra de linha
+        destino[n - 1] = '\n';
+    }
+    return n;
+#endif
+}
+
+// Escreve uma mensagem no console (somente a task de drenagem)
+static void escrever(const char *dados, uint16_t tamanho)
+{
+    if(tamanho == 0)
+        return;
+#if LOG_MODO == LOG_MODO_BINARIO
+    log_binario_escrever(stdout, (const uint8_t *)dados, tamanho);
+#else
+    fwrite(dados, 1, tamanho, stdout);
+#endif
+}
+
+// Mensagem própria da task de drenagem, escrita direto sem passar pelo ring
+static void dreno_printf(const char *fmt, ...)
+{
+    char buffer[LOG_TAM_LINHA];
+    va_list args;
+
+    va_start(args, fmt);
+    uint16_t n = formatar(buffer, fmt, args);
+    va_end(args);
+    escrever(buffer, n);
+}
+
+// ==========================================
+// Lado dos produtores
+bool log_async_printf(const char *fmt, ...)
+{
+    uint32_t pos = atomic_load_explicit(&head, memory_order_relaxed);
+    log_slot_t *slot;
+
+    while(1)
+    {
+        slot = &slots[pos & (LOG_CAPACIDADE - 1)];
+        int32_t dif = (int32_t)(atomic_load_explicit(&slot->seq, memory_order_acquire) - pos);
+
+        if(dif == 0)
+        {
+            // Slot livre: tenta reservá-lo
+            if(atomic_compare_exchange_weak_explicit(&head, &pos, pos + 1,
+                                                     memory_order_relaxed, memory_order_relaxed))
+                break;
+        }
+        else if(dif < 0)
+        {
+            // Ring cheio: descarta sem bloquear
+            atomic_fetch_add_explicit(&descartadas, 1, memory_order_relaxed);
+            return false;
+        }
+        else
+        {
+            pos = atomic_load_explicit(&head, memory_order_relaxed); // Outro produtor avançou
+        }
+    }
+
+    va_list args;
+    va_start(args, fmt);
+    uint16_t n = formatar(slot->texto, fmt, args);
+    va_end(args);
+    slot->tamanho = n;
+
+    atomic_store_explicit(&slot->seq, pos + 1, memory_order_release); // Publica o slot (vazio é só pulado)
+    if(n == 0)
+    {
+        // Mensagem que não pôde ser formatada: aparece como descarte
+        atomic_fetch_add_explicit(&descartadas, 1, memory_order_relaxed);
+        return false;
+    }
+    atomic_fetch_add_explicit(&enviadas, 1, memory_order_relaxed);
+    return true;
+}
+
+// ==========================================
+// Task de drenagem: única leitora do ring, única que escreve no console
+static void log_async_task(void *pv)
+{
+    uint32_t descartes_reportados = 0;
+    TickType_t ultimo_anuncio = xTaskGetTickCount();
+
+    while(1)
+    {
+        log_slot_t *slot = &slots[tail & (LOG_CAPACIDADE - 1)];
+
+        while(atomic_load_explicit(&slot->seq, memory_order_acquire) == tail + 1)
+        {
+            uint16_t n = slot->tamanho;
+            escrever(slot->texto, n);
+
+            // Libera o slot para a próxima volta do ring
+            atomic_store_explicit(&slot->seq, tail + LOG_CAPACIDADE, memory_order_release);
+            if(n > 0)
+                atomic_fetch_add_explicit(&escritas, 1, memory_order_relaxed);
+            tail++;
+            slot = &slots[tail & (LOG_CAPACIDADE - 1)];
+        }
+
+        uint32_t descartes = atomic_load_explicit(&descartadas, memory_order_relaxed);
+        if(descartes != descartes_reportados)
+        {
+            dreno_printf("{Cleber Dilenes - RM:89056} [LOG] %lu mensagens descartadas (ring cheio ou formato)\n",
+                         descartes - descartes_reportados);
+            descartes_reportados = descartes;
+        }
+
+#if LOG_MODO == LOG_MODO_BINARIO
+        if(xTaskGetTickCount() - ultimo_anuncio >= pdMS_TO_TICKS(LOG_BIN_REANUNCIO_MS))
+        {
+            log_binario_reanunciar();
+            ultimo_anuncio = xTaskGetTickCount();
+        }
+#else
+        (void)ultimo_anuncio;
+#endif
+
+        fflush(stdout);
+        vTaskDelay(pdMS_TO_TICKS(LOG_PERIODO_DRENO_MS));
+    }
+}
+
+// ==========================================
+bool log_async_init(void)
+{
+    for(uint32_t i = 0; i < LOG_CAPACIDADE; i++)
+        atomic_init(&slots[i].seq, i);
+
+#if ALOCACAO_ESTATICA
+    static StackType_t pilha[LOG_PILHA];
+    static StaticTask_t tcb;
+    return xTaskCreateStaticPinnedToCore(log_async_task, "LogDreno", LOG_PILHA, NULL, LOG_PRIORIDADE,
+                                         pilha, &tcb, LOG_NUCLEO) != NULL;
+#else
+    return xTaskCreatePinnedToCore(log_async_task, "LogDreno", LOG_PILHA, NULL, LOG_PRIORIDADE, NULL, LOG_NUCLEO) == pdPASS;
+#endif
+}
+
+void log_async_estatisticas(log_async_stats_t *stats)
+{
+    stats->enviadas = atomic_load_explicit(&enviadas, memory_order_relaxed);
+    stats->escritas = atomic_load_explicit(&escritas, memory_order_relaxed);
+    stats->descartadas = atomic_load_explicit(&descartadas, memory_order_relaxed);
+}
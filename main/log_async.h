@@ -0,0 +1,34 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Log assíncrono não bloqueante
+ * As tasks formatam a mensagem em um slot de um ring lock-free (vários produtores)
+ * e seguem em frente; uma task de baixa prioridade esvazia o ring no console.
+ * Com o ring cheio a mensagem é descartada e contabilizada, nunca bloqueia na UART.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct
+{
+    uint32_t enviadas;   // Mensagens aceitas no ring
+    uint32_t escritas;   // Mensagens já escritas no console
+    uint32_t descartadas; // Mensagens perdidas por ring cheio ou sem formatação possível
+} log_async_stats_t;
+
+// Prepara o ring e cria a task de drenagem. Deve ser chamada antes do primeiro log_printf.
+bool log_async_init(void);
+
+// Formata e enfileira uma mensagem. Retorna false se ela foi descartada.
+bool log_async_printf(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+// Copia os contadores do log.
+void log_async_estatisticas(log_async_stats_t *stats);
+
+// Substituto do printf nas tasks do sistema
+#define log_printf(fmt, ...) log_async_printf(fmt, ##__VA_ARGS__)
@@ -0,0 +1,285 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Implementação do log binário com formatação adiada
+ * Produtores: obtêm o ID do formato (tabela hash de ponteiros, lock-free) e
+ * serializam os argumentos conforme os especificadores % da string.
+ * Drenagem: anuncia IDs novos, calcula o CRC e aplica o enquadramento COBS.
+ */
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <string.h>
+#include "log_binario.h"
+#include "sistema_config.h"
+
+#define TABELA_TAM     256 // Entradas da tabela hash formato -> ID (potência de 2)
+#define VARINT_MAX     10  // Bytes máximos de um varint de 64 bits
+#define STRING_MAX     32  // Bytes máximos enviados para um argumento %s
+
+typedef struct
+{
+    _Atomic uintptr_t fmt; // Endereço da string de formato (0 = entrada livre)
+    atomic_uint id;        // ID publicado (0 = ainda sendo atribuído)
+} entrada_t;
+
+static entrada_t tabela[TABELA_TAM];
+static _Atomic uintptr_t formatos[LOG_BIN_MAX_IDS]; // ID -> endereço do formato
+static atomic_uint proximo_id = LOG_BIN_ID_TEXTO + 1;
+
+// Estado exclusivo da task de drenagem
+static uint32_t anunciados = LOG_BIN_ID_TEXTO + 1;
+static bool sincronizado = false;
+
+// ==========================================
+// ID do formato: procura o ponteiro na tabela e atribui um ID novo no primeiro uso.
+// Nunca espera por outro produtor; em caso de corrida o registro sai como texto.
+static uint32_t obter_id(const char *fmt)
+{
+    uintptr_t ptr = (uintptr_t)fmt;
+    uint32_t i = ((uint32_t)ptr * 2654435761u) >> 24;
+
+    for(uint32_t n = 0; n < TABELA_TAM; n++, i = (i + 1) & (TABELA_TAM - 1))
+    {
+        uintptr_t atual = atomic_load_explicit(&tabela[i].fmt, memory_order_acquire);
+
+        if(atual == 0)
+        {
+            if(atomic_compare_exchange_strong(&tabela[i].fmt, &atual, ptr))
+            {
+                uint32_t id = atomic_fetch_add(&proximo_id, 1);
+                if(id >= LOG_BIN_MAX_IDS)
+                    id = LOG_BIN_ID_TEXTO; // IDs esgotados: este formato sempre sai como texto
+                else
+                    atomic_store_explicit(&formatos[id], ptr, memory_order_release);
+                atomic_store_explicit(&tabela[i].id, id, memory_order_release);
+                return id;
+            }
+            // Perdeu a corrida: 'atual' agora contém o ponteiro vencedor
+        }
+
+        if(atual == ptr)
+        {
+            uint32_t id = atomic_load_explicit(&tabela[i].id, memory_order_acquire);
+            return id != 0 ? id : LOG_BIN_ID_TEXTO;
+        }
+    }
+    return LOG_BIN_ID_TEXTO; // Tabela cheia
+}
+
+// ==========================================
+// Serialização
+static uint8_t *escrever_varint(uint8_t *p, uint64_t v)
+{
+    while(v >= 0x80)
+    {
+        *p++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+static inline uint64_t zigzag(int64_t v)
+{
+    return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+// Registro TEXTO: o dispositivo formata (truncado ao espaço do destino)
+static size_t codificar_texto(uint8_t *destino, size_t tamanho, const char *fmt, va_list args)
+{
+    uint8_t *p = escrever_varint(destino, LOG_BIN_ID_TEXTO);
+    int n = vsnprintf((char *)p, tamanho - (p - destino), fmt, args);
+
+    if(n < 0)
+        return 0;
+    if((size_t)n >= tamanho - (p - destino))
+        n = tamanho - (p - destino) - 1;
+    return (p - destino) + n;
+}
+
+// Argumentos crus após o ID. Retorna o fim do payload, ou NULL se um argumento
+// não couber ou o especificador não for suportado.
+static uint8_t *codificar_argumentos(uint8_t *p, uint8_t *fim, const char *fmt, va_list args)
+{
+    for(const char *c = fmt; *c != '\0'; c++)
+    {
+        if(*c != '%')
+            continue;
+        c++;
+        if(*c == '%')
+            continue;
+
+        // Flags, largura e precisão (apenas '*' consome argumento)
+        while(*c != '\0' && strchr("-+ #0", *c) != NULL)
+            c++;
+        if(*c == '*')
+        {
+            p = escrever_varint(p, zigzag(va_arg(args, int)));
+            c++;
+        }
+        while(*c >= '0' && *c <= '9')
+            c++;
+        if(*c == '.')
+        {
+            c++;
+            if(*c == '*')
+            {
+                p = escrever_varint(p, zigzag(va_arg(args, int)));
+                c++;
+            }
+            while(*c >= '0' && *c <= '9')
+                c++;
+        }
+
+        // Modificador de tamanho
+        int longos = 0;
+        while(*c != '\0' && strchr("hlzjtL", *c) != NULL)
+        {
+            if(*c == 'l' || *c == 'j')
+                longos++;
+            c++;
+        }
+
+        if(fim - p < VARINT_MAX + STRING_MAX + 1)
+            return NULL; // Sem espaço para o próximo argumento
+
+        switch(*c)
+        {
+        case 'd':
+        case 'i':
+            p = escrever_varint(p, zigzag(longos >= 2 ? va_arg(args, long long) :
+                                          longos == 1 ? va_arg(args, long) : va_arg(args, int)));
+            break;
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+        case 'c':
+            p = escrever_varint(p, longos >= 2 ? va_arg(args, unsigned long long) :
+                                   longos == 1 ? va_arg(args, unsigned long) : va_arg(args, unsigned int));
+            break;
+        case 'p':
+            p = escrever_varint(p, (uintptr_t)va_arg(args, void *));
+            break;
+        case 'f':
+        case 'e':
+        case 'g':
+        {
+            double d = va_arg(args, double);
+            memcpy(p, &d, sizeof(d)); // IEEE 754 little-endian
+            p += sizeof(d);
+            break;
+        }
+        case 's':
+        {
+            const char *s = va_arg(args, const char *);
+            size_t n = s != NULL ? strnlen(s, STRING_MAX) : 0;
+            p = escrever_varint(p, n);
+            if(n > 0)
+                memcpy(p, s, n);
+            p += n;
+            break;
+        }
+        default:
+            return NULL; // Especificador não suportado
+        }
+        if(*c == '\0')
+            break;
+    }
+    return p;
+}
+
+size_t log_binario_codificar(uint8_t *destino, size_t tamanho, const char *fmt, va_list args)
+{
+    uint32_t id = obter_id(fmt);
+
+    if(tamanho < VARINT_MAX)
+        return 0;
+    if(id == LOG_BIN_ID_TEXTO)
+        return codificar_texto(destino, tamanho, fmt, args);
+
+    // Cópia dos argumentos para recomeçar como texto se o registro binário falhar
+    va_list copia;
+    va_copy(copia, args);
+    uint8_t *fim = codificar_argumentos(escrever_varint(destino, id), destino + tamanho, fmt, args);
+    size_t n = fim != NULL ? (size_t)(fim - destino) : codificar_texto(destino, tamanho, fmt, copia);
+    va_end(copia);
+    return n;
+}
+
+// ==========================================
+// Enquadramento (usado apenas pela task de drenagem)
+static uint8_t crc8(const uint8_t *dados, size_t n)
+{
+    uint8_t crc = 0;
+    while(n--)
+    {
+        crc ^= *dados++;
+        for(int b = 0; b < 8; b++)
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+    }
+    return crc;
+}
+
+static void escrever_quadro(FILE *saida, const uint8_t *payload, size_t tamanho)
+{
+    uint8_t quadro[LOG_TAM_LINHA + LOG_TAM_LINHA / 254 + 4];
+    uint8_t crc = crc8(payload, tamanho);
+    size_t codigo = 0; // Posição do byte de código COBS atual
+    size_t n = 1;
+
+    if(!sincronizado)
+    {
+        fputc(0x00, saida); // Separa o texto de boot do primeiro quadro
+        sincronizado = true;
+    }
+
+    for(size_t i = 0; i <= tamanho; i++)
+    {
+        uint8_t b = i < tamanho ? payload[i] : crc;
+        if(b != 0)
+            quadro[n++] = b;
+        if(b == 0 || n - codigo == 0xFF)
+        {
+            quadro[codigo] = (uint8_t)(n - codigo);
+            codigo = n++;
+        }
+    }
+    quadro[codigo] = (uint8_t)(n - codigo);
+    quadro[n++] = 0x00; // Delimitador
+
+    fwrite(quadro, 1, n, saida);
+}
+
+static void anunciar_pendentes(FILE *saida)
+{
+    while(anunciados < LOG_BIN_MAX_IDS)
+    {
+        uintptr_t ptr = atomic_load_explicit(&formatos[anunciados], memory_order_acquire);
+        if(ptr == 0)
+            break; // ID ainda não atribuído
+
+        uint8_t def[2 * VARINT_MAX + 4];
+        uint8_t *p = escrever_varint(def, LOG_BIN_ID_DEF);
+        p = escrever_varint(p, anunciados);
+        for(int b = 0; b < 4; b++)
+            *p++ = (uint8_t)((uint32_t)ptr >> (8 * b));
+
+        escrever_quadro(saida, def, p - def);
+        anunciados++;
+    }
+}
+
+void log_binario_escrever(FILE *saida, const uint8_t *payload, size_t tamanho)
+{
+    anunciar_pendentes(saida);
+    escrever_quadro(saida, payload, tamanho);
+}
+
+void log_binario_reanunciar(void)
+{
+    anunciados = LOG_BIN_ID_TEXTO + 1;
+}
@@ -0,0 +1,37 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Log binário com formatação adiada (estilo defmt)
+ * O dispositivo não formata texto: cada mensagem vira um registro com o ID do
+ * formato e os argumentos crus (varints). O ID é atribuído na primeira vez que
+ * um formato é usado e anunciado ao host com o endereço da string no ELF;
+ * o log_decoder.py reconstrói o texto a partir de build/hello_world.elf.
+ *
+ * Quadro no fio: COBS(payload + crc8) seguido de 0x00
+ *   payload LOG:     varint(id >= 2) argumentos...
+ *   payload DEF:     varint(0) varint(id) u32 endereço do formato (little-endian)
+ *   payload TEXTO:   varint(1) bytes de texto já formatado (tabela de IDs cheia)
+ */
+
+#pragma once
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define LOG_BIN_ID_DEF   0
+#define LOG_BIN_ID_TEXTO 1
+
+// Codifica o registro de 'fmt' com seus argumentos em 'destino'. Se os argumentos
+// não couberem ou houver um especificador não suportado, o registro sai como TEXTO.
+// Retorna o número de bytes do payload (0 se nem o texto puder ser formatado).
+size_t log_binario_codificar(uint8_t *destino, size_t tamanho, const char *fmt, va_list args);
+
+// Escreve um payload como quadro COBS, anunciando antes os formatos ainda não anunciados.
+void log_binario_escrever(FILE *saida, const uint8_t *payload, size_t tamanho);
+
+// Força o reenvio de todos os anúncios (para um decodificador que conectou depois).
+void log_binario_reanunciar(void);
@@ -0,0 +1,83 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Implementação do acumulador de lotes
+ * A espera registrada é a do item mais antigo do lote: é a latência máxima que
+ * o acúmulo acrescenta a qualquer amostra.
+ */
+
+#include "esp_timer.h"
+#include "lote.h"
+#include "log_async.h"
+
+void lote_init(lote_t *l, uint32_t limite_n, uint32_t limite_us)
+{
+    l->n = 0;
+    l->limite_n = (limite_n == 0 || limite_n > LOTE_N) ? LOTE_N : limite_n;
+    l->limite_us = limite_us;
+    l->t_primeiro_us = 0;
+    l->descargas_tamanho = 0;
+    l->descargas_tempo = 0;
+    l->enviados = 0;
+    l->descartados = 0;
+    histograma_init(&l->espera_us);
+}
+
+static uint32_t descarregar(lote_t *l, int64_t agora)
+{
+    uint32_t enviados = transporte_enviar_lote(l->itens, l->n);
+    uint32_t descartados = l->n - enviados;
+
+    histograma_registrar(&l->espera_us, (uint32_t)(agora - l->t_primeiro_us));
+    l->enviados += enviados;
+    l->descartados += descartados;
+    l->n = 0;
+    return descartados;
+}
+
+uint32_t lote_adicionar(lote_t *l, const fila_item_t *item)
+{
+    int64_t agora = esp_timer_get_time();
+
+    if(l->n == 0)
+        l->t_primeiro_us = agora;
+    l->itens[l->n++] = *item;
+
+    if(l->n >= l->limite_n)
+    {
+        l->descargas_tamanho++;
+        return descarregar(l, agora);
+    }
+    return 0;
+}
+
+uint32_t lote_verificar_prazo(lote_t *l)
+{
+    int64_t agora = esp_timer_get_time();
+
+    if(l->n == 0 || agora < lote_prazo_us(l))
+        return 0;
+    l->descargas_tempo++;
+    return descarregar(l, agora);
+}
+
+int64_t lote_prazo_us(const lote_t *l)
+{
+    return l->n > 0 ? l->t_primeiro_us + l->limite_us : INT64_MAX;
+}
+
+void lote_relatorio(const lote_t *l)
+{
+    uint32_t descargas = l->descargas_tamanho + l->descargas_tempo;
+    histograma_resumo_t espera;
+    histograma_resumo(&l->espera_us, &espera);
+
+    log_printf("   - Lotes (N=%lu, T=%lu us): média %lu itens, %lu descartados\n",
+               l->limite_n, l->limite_us, descargas > 0 ? (l->enviados + l->descartados) / descargas : 0,
+               l->descartados);
+    log_printf("   - Descargas do lote: %lu (%lu por tamanho, %lu por tempo)\n",
+               descargas, l->descargas_tamanho, l->descargas_tempo);
+    log_printf("   - Espera no lote: p50 %lu us, p99 %lu us, máx %lu us\n", espera.p50, espera.p99, espera.maximo);
+}
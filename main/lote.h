@@ -0,0 +1,50 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Acumulador de lotes da Task1
+ * As amostras são acumuladas até completar N itens ou até o primeiro item do
+ * lote esperar T µs, o que vier antes; o lote inteiro é entregue ao transporte
+ * em uma única operação (uma sincronização por lote em vez de uma por amostra).
+ * Usado por uma única task produtora.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "transporte.h"
+#include "histograma.h"
+#include "sistema_config.h"
+
+typedef struct
+{
+    fila_item_t itens[LOTE_N];
+    uint32_t n;              // Itens acumulados
+    uint32_t limite_n;       // Descarga por tamanho (1..LOTE_N)
+    uint32_t limite_us;      // Descarga por tempo: espera máxima do primeiro item
+    int64_t t_primeiro_us;   // Chegada do primeiro item do lote atual
+
+    // Estatísticas (escritas só pela task dona)
+    uint32_t descargas_tamanho;
+    uint32_t descargas_tempo;
+    uint32_t enviados;
+    uint32_t descartados;    // Itens recusados pelo transporte (fila cheia)
+    histograma_t espera_us;  // Espera do primeiro item até a descarga
+} lote_t;
+
+// Configura os limites N (itens) e T (µs). 'limite_n' é limitado a LOTE_N.
+void lote_init(lote_t *l, uint32_t limite_n, uint32_t limite_us);
+
+// Acrescenta um item; descarrega se o lote completar. Retorna os itens descartados.
+uint32_t lote_adicionar(lote_t *l, const fila_item_t *item);
+
+// Descarrega se o prazo do lote venceu. Retorna os itens descartados.
+uint32_t lote_verificar_prazo(lote_t *l);
+
+// Instante (esp_timer, µs) em que o lote atual vence; INT64_MAX se vazio.
+int64_t lote_prazo_us(const lote_t *l);
+
+// Loga o resumo das descargas (uso no logger).
+void lote_relatorio(const lote_t *l);
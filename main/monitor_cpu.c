@@ -0,0 +1,98 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Implementação das estatísticas de execução por task
+ * Os retratos ficam em buffers estáticos (sem heap) e as tasks são casadas
+ * entre retratos pelo handle. Percentual de CPU = tempo da task no intervalo
+ * dividido pela capacidade total (tempo decorrido x número de núcleos).
+ */
+
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "monitor_cpu.h"
+#include "log_async.h"
+#include "sistema_config.h"
+
+static TaskStatus_t retratos[2][MONITOR_MAX_TASKS];
+static UBaseType_t quantidade[2];
+static uint32_t total_anterior;
+static int atual = 0;       // Índice do retrato mais recente
+static bool iniciado = false;
+
+static char letra_estado(eTaskState estado)
+{
+    switch(estado)
+    {
+    case eRunning:   return 'X'; // Executando
+    case eReady:     return 'P'; // Pronta
+    case eBlocked:   return 'B'; // Bloqueada
+    case eSuspended: return 'S'; // Suspensa
+    case eDeleted:   return 'D'; // Removida
+    default:         return '?';
+    }
+}
+
+// Procura a task no retrato anterior; retorna NULL se ela é nova
+static const TaskStatus_t *anterior(int indice, TaskHandle_t handle)
+{
+    for(UBaseType_t i = 0; i < quantidade[indice]; i++)
+    {
+        if(retratos[indice][i].xHandle == handle)
+            return &retratos[indice][i];
+    }
+    return NULL;
+}
+
+void monitor_cpu_relatorio(void)
+{
+    int novo = atual ^ 1;
+    uint32_t total;
+
+    quantidade[novo] = uxTaskGetSystemState(retratos[novo], MONITOR_MAX_TASKS, &total);
+    if(quantidade[novo] == 0)
+    {
+        log_printf("   - CPU: mais de %d tasks, aumente MONITOR_MAX_TASKS\n", MONITOR_MAX_TASKS);
+        return;
+    }
+
+    uint32_t decorrido = total - total_anterior; // Contador de 32 bits: subtração tolera a volta
+    bool valido = iniciado && decorrido > 0;
+    total_anterior = total;
+    atual = novo;
+    iniciado = true;
+    if(!valido)
+        return; // Primeiro retrato: apenas referência
+
+    uint64_t capacidade = (uint64_t)decorrido * configNUMBER_OF_CORES;
+
+    // Ociosidade por núcleo (tasks IDLE de cada núcleo)
+    uint32_t ocioso[configNUMBER_OF_CORES] = {0};
+    for(BaseType_t nucleo = 0; nucleo < configNUMBER_OF_CORES; nucleo++)
+    {
+        TaskHandle_t idle = xTaskGetIdleTaskHandleForCore(nucleo);
+        const TaskStatus_t *agora = anterior(novo, idle);
+        const TaskStatus_t *antes = anterior(novo ^ 1, idle);
+        if(agora != NULL && antes != NULL)
+            ocioso[nucleo] = (uint32_t)((uint64_t)(agora->ulRunTimeCounter - antes->ulRunTimeCounter) * 100 / decorrido);
+    }
+    log_printf("   - CPU ociosa: núcleo 0 %lu%%, núcleo 1 %lu%% (intervalo %lu ms)\n",
+               ocioso[0], configNUMBER_OF_CORES > 1 ? ocioso[1] : 0, decorrido / 1000);
+
+    // Uma linha por task: CPU no intervalo, pilha livre mínima, estado e afinidade
+    for(UBaseType_t i = 0; i < quantidade[novo]; i++)
+    {
+        const TaskStatus_t *t = &retratos[novo][i];
+        const TaskStatus_t *antes = anterior(novo ^ 1, t->xHandle);
+        uint32_t delta = antes != NULL ? t->ulRunTimeCounter - antes->ulRunTimeCounter : t->ulRunTimeCounter;
+        uint32_t permil = (uint32_t)((uint64_t)delta * 1000 / capacidade);
+        BaseType_t nucleo = xTaskGetCoreID(t->xHandle);
+
+        log_printf("   - %-12s cpu %2lu.%lu%%  pilha livre %5lu B  estado %c  núcleo %c  prio %lu\n",
+                   t->pcTaskName, permil / 10, permil % 10, (uint32_t)t->usStackHighWaterMark,
+                   letra_estado(t->eCurrentState), nucleo == tskNO_AFFINITY ? '-' : (char)('0' + nucleo),
+                   (uint32_t)t->uxCurrentPriority);
+    }
+}
@@ -0,0 +1,17 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Estatísticas de execução por task para o logger (Task4)
+ * Usa uxTaskGetSystemState (CONFIG_FREERTOS_USE_TRACE_FACILITY e
+ * CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS) e calcula os valores como
+ * diferença entre duas chamadas consecutivas, ou seja, por intervalo de relatório.
+ */
+
+#pragma once
+
+// Coleta um novo retrato das tasks e imprime, via log_printf, o uso de CPU
+// de cada task no intervalo, a ociosidade de cada núcleo, a pilha livre mínima
+// e o estado de cada task. A primeira chamada apenas inicializa a referência.
+void monitor_cpu_relatorio(void);
@@ -0,0 +1,72 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Implementação do perfil de pilhas
+ * A marca d'água é o mínimo de pilha livre desde a criação da task, então não
+ * é preciso amostrar: basta lê-la depois da carga de estresse. Os handles são
+ * procurados pelo nome, o que inclui tasks criadas fora do app_main (LogDreno).
+ */
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "perfil_pilha.h"
+#include "log_async.h"
+#include "sistema_config.h"
+
+#define PERFIL_PILHA_MAX      8
+#define PERFIL_PILHA_MULTIPLO 256  // Arredondamento do tamanho recomendado
+#define PERFIL_PILHA_MINIMA   2048 // Piso: chamadas de biblioteca fora do caminho medido
+
+typedef struct
+{
+    const char *nome;
+    const char *macro;
+    uint32_t pilha;
+} perfil_pilha_t;
+
+static perfil_pilha_t tasks[PERFIL_PILHA_MAX];
+static uint32_t quantidade;
+
+void perfil_pilha_registrar(const char *nome, const char *macro, uint32_t pilha)
+{
+    if(quantidade < PERFIL_PILHA_MAX)
+        tasks[quantidade++] = (perfil_pilha_t){ .nome = nome, .macro = macro, .pilha = pilha };
+}
+
+static uint32_t recomendada(uint32_t usada)
+{
+    uint32_t r = usada * (100 + PERFIL_PILHAS_MARGEM_PCT) / 100;
+    r = (r + PERFIL_PILHA_MULTIPLO - 1) / PERFIL_PILHA_MULTIPLO * PERFIL_PILHA_MULTIPLO;
+    return r < PERFIL_PILHA_MINIMA ? PERFIL_PILHA_MINIMA : r;
+}
+
+void perfil_pilha_emitir(void)
+{
+    uint32_t total = 0, total_recomendado = 0;
+
+    log_printf("{Cleber Dilenes - RM:89056} [PILHAS] ---- início de pilhas_geradas.h ----\n");
+    log_printf("{Cleber Dilenes - RM:89056} [PILHAS] #pragma once\n");
+    log_printf("{Cleber Dilenes - RM:89056} [PILHAS] // Uso máximo medido + %d%%, múltiplo de %d bytes\n",
+               PERFIL_PILHAS_MARGEM_PCT, PERFIL_PILHA_MULTIPLO);
+
+    for(uint32_t i = 0; i < quantidade; i++)
+    {
+        const perfil_pilha_t *t = &tasks[i];
+        TaskHandle_t handle = xTaskGetHandle(t->nome);
+        if(handle == NULL)
+            continue;
+
+        uint32_t usada = t->pilha - uxTaskGetStackHighWaterMark(handle);
+        uint32_t r = recomendada(usada);
+        total += t->pilha;
+        total_recomendado += r;
+        log_printf("{Cleber Dilenes - RM:89056} [PILHAS] #define %s %lu // %s: usou %lu de %lu\n",
+                   t->macro, r, t->nome, usada, t->pilha);
+    }
+
+    log_printf("{Cleber Dilenes - RM:89056} [PILHAS] ---- fim ----\n");
+    log_printf("{Cleber Dilenes - RM:89056} [PILHAS] Total %lu -> %lu bytes (%ld liberados)\n",
+               total, total_recomendado, (long)total - (long)total_recomendado);
+}
@@ -0,0 +1,21 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Perfil de uso de pilha e dimensionamento automático
+ * Com PERFIL_PILHAS=1 o logger lê periodicamente a marca d'água de cada task
+ * registrada (uxTaskGetStackHighWaterMark, em bytes no ESP-IDF) e emite um
+ * pilhas_geradas.h com o tamanho recomendado: uso máximo + margem, arredondado.
+ * gerar_pilhas.py extrai o cabeçalho da saída serial; PILHAS_GERADAS=1 o aplica.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Acompanha a task 'nome' (criada com 'pilha' bytes), cujo tamanho vem da macro 'macro'.
+void perfil_pilha_registrar(const char *nome, const char *macro, uint32_t pilha);
+
+// Loga o uso de cada task e o cabeçalho com os tamanhos recomendados (uso no logger).
+void perfil_pilha_emitir(void);
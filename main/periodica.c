@@ -0,0 +1,99 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Implementação da execução periódica com estatísticas
+ * Os campos de cada controle só são escritos pela task dona; a Task4 apenas lê
+ * (palavras de 32 bits, leitura atômica no Xtensa).
+ */
+
+#include <stdlib.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "periodica.h"
+#include "log_async.h"
+
+static periodica_t *registradas[PERIODICA_MAX];
+static portMUX_TYPE trava_registro = portMUX_INITIALIZER_UNLOCKED;
+
+void periodica_init(periodica_t *p, const char *nome, uint32_t periodo_ms)
+{
+    *p = (periodica_t){ .nome = nome, .periodo_ms = periodo_ms };
+
+    // Uma task recriada reinicia as estatísticas sem registrar o controle de novo
+    taskENTER_CRITICAL(&trava_registro);
+    for(int i = 0; i < PERIODICA_MAX; i++)
+    {
+        if(registradas[i] == NULL || registradas[i] == p)
+        {
+            registradas[i] = p;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL(&trava_registro);
+}
+
+void periodica_inicio(periodica_t *p)
+{
+    int64_t agora = esp_timer_get_time();
+
+    if(p->ativacoes == 0)
+    {
+        // Primeira ativação: referência do período e da deriva
+        p->primeiro_inicio_us = agora;
+        p->ultimo_despertar = xTaskGetTickCount();
+    }
+    else if(p->periodo_ms > 0)
+    {
+        int64_t periodo_us = (int64_t)p->periodo_ms * 1000;
+        uint32_t jitter = (uint32_t)llabs((agora - p->inicio_us) - periodo_us);
+        if(jitter > p->jitter_max_us)
+            p->jitter_max_us = jitter;
+        p->deriva_us = (int32_t)((agora - p->primeiro_inicio_us) - (int64_t)(p->ativacoes - p->ativacoes_ref) * periodo_us);
+    }
+
+    p->inicio_us = agora;
+    p->ativacoes++;
+}
+
+void periodica_ajustar(periodica_t *p, uint32_t periodo_ms)
+{
+    if(periodo_ms == p->periodo_ms || p->ativacoes == 0)
+        return;
+    p->periodo_ms = periodo_ms;
+    p->primeiro_inicio_us = p->inicio_us;
+    p->ativacoes_ref = p->ativacoes - 1; // A ativação atual já foi contada
+}
+
+void periodica_fim(periodica_t *p)
+{
+    uint32_t execucao = (uint32_t)(esp_timer_get_time() - p->inicio_us);
+    if(execucao > p->wcet_us)
+        p->wcet_us = execucao;
+}
+
+void periodica_aguardar(periodica_t *p)
+{
+    periodica_fim(p);
+
+    // pdFALSE: o próximo instante ideal já passou (a ativação estourou o período)
+    if(xTaskDelayUntil(&p->ultimo_despertar, pdMS_TO_TICKS(p->periodo_ms)) == pdFALSE)
+        p->atrasos++;
+}
+
+void periodica_relatorio(void)
+{
+    for(int i = 0; i < PERIODICA_MAX && registradas[i] != NULL; i++)
+    {
+        const periodica_t *p = registradas[i];
+
+        if(p->periodo_ms > 0)
+            log_printf("   - %-6s T=%lu ms  n=%lu  jitter máx %lu us  atrasos %lu  WCET %lu us  deriva %ld us\n",
+                       p->nome, p->periodo_ms, p->ativacoes, p->jitter_max_us, p->atrasos, p->wcet_us,
+                       (long)p->deriva_us);
+        else
+            log_printf("   - %-6s aperiódica  n=%lu  WCET %lu us\n", p->nome, p->ativacoes, p->wcet_us);
+    }
+}
@@ -0,0 +1,58 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Execução periódica sem deriva (xTaskDelayUntil) com estatísticas
+ * O período é contado a partir do instante ideal da ativação anterior, e não do
+ * fim do trabalho, então o tempo gasto (printf incluído) não alonga o período.
+ * Cada task registra jitter de período, atrasos (overruns), pior tempo de
+ * execução (WCET) e deriva acumulada; a Task4 imprime o resumo.
+ *
+ * Uso:
+ *     periodica_init(&ctl, "Task1", 1000);
+ *     while(1) { periodica_inicio(&ctl); ...trabalho...; periodica_aguardar(&ctl); }
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+
+#define PERIODICA_MAX 8 // Tasks acompanhadas no relatório
+
+typedef struct
+{
+    const char *nome;
+    uint32_t periodo_ms;        // 0 = task aperiódica (mede apenas WCET)
+    TickType_t ultimo_despertar; // Referência do xTaskDelayUntil
+
+    int64_t primeiro_inicio_us;
+    int64_t inicio_us;          // Início da ativação atual
+
+    uint32_t ativacoes;
+    uint32_t atrasos;           // Ativações que passaram do prazo do período
+    uint32_t jitter_max_us;     // Maior |intervalo entre inícios - período|
+    uint32_t wcet_us;           // Maior tempo de execução de uma ativação
+    int32_t deriva_us;          // Início atual - início ideal (k x período)
+    uint32_t ativacoes_ref;     // Ativação de referência da deriva (muda com o período)
+} periodica_t;
+
+// Prepara o controle e o registra para o relatório. periodo_ms = 0: aperiódica.
+void periodica_init(periodica_t *p, const char *nome, uint32_t periodo_ms);
+
+// Marca o início do trabalho da ativação (mede jitter e deriva).
+void periodica_inicio(periodica_t *p);
+
+// Marca o fim do trabalho (mede o tempo de execução).
+void periodica_fim(periodica_t *p);
+
+// Troca o período a partir da ativação atual (chamar após periodica_inicio).
+// A deriva passa a ser medida desde esta ativação, com o novo período.
+void periodica_ajustar(periodica_t *p, uint32_t periodo_ms);
+
+// periodica_fim e bloqueia até o próximo instante ideal de ativação.
+void periodica_aguardar(periodica_t *p);
+
+// Imprime, via log_printf, uma linha por task registrada.
+void periodica_relatorio(void);
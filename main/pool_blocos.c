@@ -0,0 +1,86 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Implementação do pool de blocos de tamanho fixo
+ * Alocar e liberar apenas movem o topo da lista de livres (O(1), sem laços).
+ */
+
+#include <stddef.h>
+#include "pool_blocos.h"
+
+bool pool_blocos_init(pool_blocos_t *pool, const char *nome, void *memoria,
+                      uint32_t tamanho, uint32_t quantidade)
+{
+    if(memoria == NULL || quantidade == 0 || ((uintptr_t)memoria % POOL_ALINHAMENTO) != 0)
+        return false;
+
+    uint32_t tamanho_bloco = POOL_TAMANHO_BLOCO(tamanho);
+
+    portMUX_INITIALIZE(&pool->trava);
+    pool->memoria = memoria;
+    pool->nome = nome;
+    pool->stats = (pool_blocos_stats_t){
+        .num_blocos = quantidade,
+        .tamanho_bloco = tamanho_bloco,
+    };
+
+    // Encadeia todos os blocos na lista de livres
+    pool->livres = NULL;
+    for(uint32_t i = quantidade; i > 0; i--)
+    {
+        void **bloco = (void **)(pool->memoria + (i - 1) * tamanho_bloco);
+        *bloco = pool->livres;
+        pool->livres = bloco;
+    }
+    return true;
+}
+
+void *pool_blocos_alocar(pool_blocos_t *pool)
+{
+    taskENTER_CRITICAL(&pool->trava);
+    void **bloco = pool->livres;
+    if(bloco != NULL)
+    {
+        pool->livres = *bloco;
+        pool->stats.alocacoes++;
+        if(++pool->stats.em_uso > pool->stats.pico)
+            pool->stats.pico = pool->stats.em_uso;
+    }
+    else
+    {
+        pool->stats.falhas++; // Pool esgotado
+    }
+    taskEXIT_CRITICAL(&pool->trava);
+    return bloco;
+}
+
+bool pool_blocos_liberar(pool_blocos_t *pool, void *bloco)
+{
+    uintptr_t deslocamento = (uintptr_t)bloco - (uintptr_t)pool->memoria;
+    bool valido = bloco != NULL &&
+                  deslocamento < (uintptr_t)pool->stats.num_blocos * pool->stats.tamanho_bloco &&
+                  deslocamento % pool->stats.tamanho_bloco == 0;
+
+    taskENTER_CRITICAL(&pool->trava);
+    if(valido)
+    {
+        *(void **)bloco = pool->livres;
+        pool->livres = bloco;
+        pool->stats.em_uso--;
+    }
+    else
+    {
+        pool->stats.liberacoes_invalidas++;
+    }
+    taskEXIT_CRITICAL(&pool->trava);
+    return valido;
+}
+
+void pool_blocos_estatisticas(pool_blocos_t *pool, pool_blocos_stats_t *stats)
+{
+    taskENTER_CRITICAL(&pool->trava);
+    *stats = pool->stats;
+    taskEXIT_CRITICAL(&pool->trava);
+}
@@ -0,0 +1,60 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Pool de blocos de tamanho fixo (alocação determinística O(1))
+ * Substitui malloc/free no caminho de dados: a memória é reservada uma única vez
+ * e os blocos livres formam uma lista encadeada dentro da própria memória.
+ * Seguro para uso entre tasks nos dois núcleos (spinlock curto por operação).
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+
+// Alinhamento dos blocos (suficiente para int64_t/double e ponteiros)
+#define POOL_ALINHAMENTO 8
+
+// Tamanho real de um bloco: no mínimo um ponteiro e múltiplo do alinhamento
+#define POOL_TAMANHO_BLOCO(tamanho) \
+    ((((tamanho) < sizeof(void *) ? sizeof(void *) : (tamanho)) + POOL_ALINHAMENTO - 1) & ~(POOL_ALINHAMENTO - 1))
+
+// Declara a memória estática de um pool: POOL_BLOCOS_MEMORIA(mem_amostras, sizeof(int), 8);
+#define POOL_BLOCOS_MEMORIA(nome, tamanho, quantidade) \
+    static uint8_t nome[POOL_TAMANHO_BLOCO(tamanho) * (quantidade)] __attribute__((aligned(POOL_ALINHAMENTO)))
+
+typedef struct
+{
+    uint32_t em_uso;          // Blocos alocados no momento
+    uint32_t pico;            // Maior valor de em_uso já observado (high-water)
+    uint32_t falhas;          // Alocações recusadas por falta de bloco livre
+    uint32_t alocacoes;       // Total de alocações bem-sucedidas
+    uint32_t liberacoes_invalidas; // Ponteiros fora do pool ou desalinhados
+    uint32_t num_blocos;
+    uint32_t tamanho_bloco;
+} pool_blocos_stats_t;
+
+typedef struct
+{
+    portMUX_TYPE trava;
+    void *livres;             // Topo da lista de blocos livres
+    uint8_t *memoria;
+    const char *nome;
+    pool_blocos_stats_t stats;
+} pool_blocos_t;
+
+// Inicializa o pool sobre 'memoria' (declarada com POOL_BLOCOS_MEMORIA).
+bool pool_blocos_init(pool_blocos_t *pool, const char *nome, void *memoria,
+                      uint32_t tamanho, uint32_t quantidade);
+
+// Retorna um bloco livre ou NULL se o pool estiver esgotado.
+void *pool_blocos_alocar(pool_blocos_t *pool);
+
+// Devolve um bloco ao pool. Retorna false se o ponteiro não pertencer ao pool.
+bool pool_blocos_liberar(pool_blocos_t *pool, void *bloco);
+
+// Copia as estatísticas atuais do pool.
+void pool_blocos_estatisticas(pool_blocos_t *pool, pool_blocos_stats_t *stats);
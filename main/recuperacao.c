@@ -0,0 +1,194 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Implementação do gerente de recuperação
+ * A confirmação da parada usa um semáforo binário estático: as notificações da
+ * task que recupera (Task2) já são usadas pelo transporte em ring.
+ * A task confirma antes do vTaskDelete(NULL), e o TCB de quem se remove só é
+ * liberado depois, pela idle task do seu núcleo. Por isso a recriação espera
+ * também a callback de remoção do TLS (prvDeleteTCB): só então a pilha e o
+ * TCB estáticos podem ser reutilizados. Com a idle sem CPU por mais de
+ * REC_LIBERACAO_MS a recriação estática falha (e o nível CHIP assume), em vez
+ * de corromper as listas do kernel. MTTR de um incidente: do último nível
+ * aplicado até o próximo dado, atribuído a esse nível. No nível CHIP o
+ * incidente atravessa o reset (recuperacao_importar) e o instante da ação
+ * fica antes do zero do esp_timer.
+ */
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_task_wdt.h"
+#include "esp_timer.h"
+#include "recuperacao.h"
+#include "log_async.h"
+#include "sistema_config.h"
+
+#define REC_MAX_TASKS   (4 + PRODUTORES) // Tasks do sistema e produtores extras
+#define REC_PARADA_MS   2000 // Prazo para a task atender o pedido de parada
+#define REC_LIBERACAO_MS 1000 // Prazo para a idle task liberar o TCB removido
+#define REC_TLS_INDICE   0    // CONFIG_FREERTOS_THREAD_LOCAL_STORAGE_POINTERS=1
+
+typedef struct
+{
+    uint32_t acoes;      // Vezes em que o nível foi aplicado
+    uint32_t resolvidos; // Incidentes encerrados neste nível
+    uint32_t falhas;     // Recriações que falharam (REC_TASK)
+    uint64_t soma_ms;
+    uint32_t max_ms;
+} rec_stats_t;
+
+static rec_task_t *registradas[REC_MAX_TASKS];
+static uint32_t quantidade;
+static StaticSemaphore_t confirmacao_mem;
+static SemaphoreHandle_t confirmacao;
+static StaticSemaphore_t liberacao_mem;
+static SemaphoreHandle_t liberacao; // TCB de uma task registrada foi liberado
+
+static rec_stats_t stats[REC_NIVEIS];
+static int ultimo_nivel = -1;  // -1: sem incidente em andamento
+static int64_t ultima_acao_us;
+
+static const char *const nomes[REC_NIVEIS] = { "leve", "moderada", "task", "chip" };
+
+void recuperacao_init(void)
+{
+    confirmacao = xSemaphoreCreateBinaryStatic(&confirmacao_mem);
+    liberacao = xSemaphoreCreateBinaryStatic(&liberacao_mem);
+}
+
+// Chamada pelo kernel ao liberar o TCB (idle task ou vTaskDelete de outra task)
+static void ao_liberar_tcb(int indice, void *task)
+{
+    xSemaphoreGive(liberacao);
+}
+
+bool recuperacao_criar_task(rec_task_t *t)
+{
+    bool registrada = false;
+    for(uint32_t i = 0; i < quantidade; i++)
+        registrada |= registradas[i] == t;
+    if(!registrada && quantidade < REC_MAX_TASKS)
+        registradas[quantidade++] = t;
+
+    atomic_store(&t->parar, false);
+#if ALOCACAO_ESTATICA
+    t->handle = xTaskCreateStaticPinnedToCore(t->funcao, t->nome, t->pilha, t->parametro, t->prioridade,
+                                              t->memoria_pilha, t->tcb, t->nucleo);
+#else
+    if(xTaskCreatePinnedToCore(t->funcao, t->nome, t->pilha, t->parametro, t->prioridade,
+                               &t->handle, t->nucleo) != pdPASS)
+        t->handle = NULL;
+#endif
+    if(t->handle == NULL)
+        return false;
+    vTaskSetThreadLocalStoragePointerAndDelCallback(t->handle, REC_TLS_INDICE, t, ao_liberar_tcb);
+    return true;
+}
+
+void recuperacao_ponto_parada(void)
+{
+    TaskHandle_t eu = xTaskGetCurrentTaskHandle();
+
+    for(uint32_t i = 0; i < quantidade; i++)
+    {
+        rec_task_t *t = registradas[i];
+        if(t->handle == eu && atomic_load(&t->parar))
+        {
+            esp_task_wdt_delete(NULL);
+            xSemaphoreGive(confirmacao);
+            vTaskDelete(NULL);
+        }
+    }
+}
+
+bool recuperacao_reiniciar_task(rec_task_t *t)
+{
+    xSemaphoreTake(confirmacao, 0); // Descarta confirmações antigas
+    xSemaphoreTake(liberacao, 0);
+    atomic_store(&t->parar, true);
+
+    if(xSemaphoreTake(confirmacao, pdMS_TO_TICKS(REC_PARADA_MS)) != pdTRUE)
+    {
+        // Não chegou ao ponto de parada: remove à força
+        log_printf("{Cleber Dilenes - RM:89056} [RECUPERACAO] %s não respondeu, removendo à força\n", t->nome);
+        esp_task_wdt_delete(t->handle);
+        vTaskDelete(t->handle);
+    }
+
+    // A task deixou de existir só quando o kernel libera o TCB
+    bool liberada = xSemaphoreTake(liberacao, pdMS_TO_TICKS(REC_LIBERACAO_MS)) == pdTRUE;
+    t->handle = NULL;
+
+    if(t->limpar != NULL)
+        t->limpar();
+
+    bool ok;
+    if(!liberada && ALOCACAO_ESTATICA)
+    {
+        // Reutilizar o TCB ainda na lista de remoção corromperia o kernel
+        log_printf("{Cleber Dilenes - RM:89056} [RECUPERACAO] TCB de %s não liberado em %d ms\n",
+                   t->nome, REC_LIBERACAO_MS);
+        ok = false;
+    }
+    else
+    {
+        ok = recuperacao_criar_task(t); // No perfil com heap a task nova tem memória própria
+    }
+    if(!ok)
+        stats[REC_TASK].falhas++;
+    log_printf("{Cleber Dilenes - RM:89056} [RECUPERACAO] %s %s\n", t->nome, ok ? "recriada" : "não pôde ser recriada");
+    return ok;
+}
+
+void recuperacao_aplicada(rec_nivel_t nivel)
+{
+    stats[nivel].acoes++;
+    ultimo_nivel = nivel;
+    ultima_acao_us = esp_timer_get_time();
+}
+
+void recuperacao_dados_ok(void)
+{
+    if(ultimo_nivel < 0)
+        return;
+
+    rec_stats_t *s = &stats[ultimo_nivel];
+    uint32_t ms = (uint32_t)((esp_timer_get_time() - ultima_acao_us) / 1000);
+    s->resolvidos++;
+    s->soma_ms += ms;
+    if(ms > s->max_ms)
+        s->max_ms = ms;
+    ultimo_nivel = -1;
+}
+
+void recuperacao_exportar(uint32_t acoes[REC_NIVEIS], int *nivel, uint32_t *desde_ms)
+{
+    for(int n = 0; n < REC_NIVEIS; n++)
+        acoes[n] = stats[n].acoes;
+    *nivel = ultimo_nivel;
+    *desde_ms = ultimo_nivel < 0 ? 0 : (uint32_t)((esp_timer_get_time() - ultima_acao_us) / 1000);
+}
+
+void recuperacao_importar(const uint32_t acoes[REC_NIVEIS], int nivel, uint32_t desde_ms)
+{
+    for(int n = 0; n < REC_NIVEIS; n++)
+        stats[n].acoes = acoes[n];
+    ultimo_nivel = nivel >= 0 && nivel < REC_NIVEIS ? nivel : -1;
+    ultima_acao_us = esp_timer_get_time() - (int64_t)desde_ms * 1000;
+}
+
+void recuperacao_relatorio(void)
+{
+    for(int n = 0; n < REC_NIVEIS; n++)
+    {
+        const rec_stats_t *s = &stats[n];
+        if(s->acoes == 0)
+            continue;
+        log_printf("   - Recuperação %-8s: %lu ações, %lu resolvidas, MTTR médio %lu ms, máx %lu ms, %lu falhas\n",
+                   nomes[n], s->acoes, s->resolvidos,
+                   s->resolvidos > 0 ? (uint32_t)(s->soma_ms / s->resolvidos) : 0, s->max_ms, s->falhas);
+    }
+}
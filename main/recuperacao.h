@@ -0,0 +1,80 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Gerente de recuperação em nível de task
+ * Em vez de reiniciar o chip, a task com falha é parada e recriada. A parada é
+ * cooperativa: a task chama recuperacao_ponto_parada() em um ponto seguro do
+ * laço e se encerra ao receber o pedido. Se não responder no prazo, é removida
+ * à força. O reset do chip fica como último nível, quando a recriação falha.
+ * A remoção à força pode interromper a task em qualquer ponto: o que ela tinha
+ * em mãos (ex.: um bloco de dados ainda não enviado) deve ser devolvido pelo
+ * 'limpar'. Um envio ao ring interrompido se perde sem ficar meio publicado
+ * (o head é publicado por um único store); no modo QUEUE o envio é atômico.
+ * O tempo médio até a recuperação (MTTR) é medido por nível.
+ */
+
+#pragma once
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+typedef enum
+{
+    REC_LEVE,     // Apenas sinaliza
+    REC_MODERADA, // Esvazia a fila
+    REC_TASK,     // Recria a task produtora
+    REC_CHIP,     // esp_restart()
+    REC_NIVEIS
+} rec_nivel_t;
+
+// Descrição de uma task recriável (memória estática ou NULL no perfil com heap)
+typedef struct
+{
+    TaskFunction_t funcao;
+    void *parametro;        // Argumento da task (NULL para as tasks do sistema)
+    const char *nome;
+    uint32_t pilha;
+    UBaseType_t prioridade;
+    BaseType_t nucleo;
+    StackType_t *memoria_pilha;
+    StaticTask_t *tcb;
+    void (*limpar)(void);   // Libera recursos da task removida antes de recriá-la (ou NULL)
+
+    TaskHandle_t handle;    // Preenchidos pelo gerente
+    atomic_bool parar;
+} rec_task_t;
+
+// Prepara o gerente (antes de criar as tasks).
+void recuperacao_init(void);
+
+// Cria a task descrita e a registra no gerente. Retorna false se a criação falhar.
+bool recuperacao_criar_task(rec_task_t *task);
+
+// Chamada pela própria task em um ponto seguro: se houver pedido de parada,
+// sai do WDT e se encerra (não retorna).
+void recuperacao_ponto_parada(void);
+
+// Para (cooperativamente ou à força) e recria a task. Retorna false se a recriação falhar.
+bool recuperacao_reiniciar_task(rec_task_t *task);
+
+// Marca a aplicação de um nível de recuperação no incidente atual.
+void recuperacao_aplicada(rec_nivel_t nivel);
+
+// Dados voltaram: encerra o incidente e contabiliza o MTTR do maior nível aplicado.
+void recuperacao_dados_ok(void);
+
+// Estado a preservar entre resets (estado_rtc.c): ações por nível, nível do
+// incidente em andamento (-1 se nenhum) e ms desde a última ação.
+void recuperacao_exportar(uint32_t acoes[REC_NIVEIS], int *nivel, uint32_t *desde_ms);
+
+// Restaura o estado exportado antes do reset. Um incidente em andamento continua
+// aberto: seu MTTR inclui 'desde_ms' mais o tempo de boot até o primeiro dado.
+void recuperacao_importar(const uint32_t acoes[REC_NIVEIS], int nivel, uint32_t desde_ms);
+
+// Loga ações e MTTR por nível (uso no logger).
+void recuperacao_relatorio(void);
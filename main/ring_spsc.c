@@ -0,0 +1,136 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Implementação do ring buffer SPSC lock-free
+ * head e tail são contadores livres de 32 bits; a posição real é (índice & mascara).
+ * O produtor publica com release e o consumidor lê com acquire (e vice-versa),
+ * garantindo que os dados copiados fiquem visíveis no outro núcleo.
+ */
+
+#include <string.h>
+#include "ring_spsc.h"
+
+// ==========================================
+// Cópia de n itens a partir da posição inicial, tratando a volta do buffer
+static void copiar_para_ring(ring_spsc_t *ring, uint32_t inicio, const uint8_t *origem, uint32_t n)
+{
+    uint32_t pos = inicio & ring->mascara;
+    uint32_t ate_fim = ring->mascara + 1 - pos; // Itens até o fim do buffer
+    uint32_t primeiro = n < ate_fim ? n : ate_fim;
+
+    memcpy(ring->buffer + pos * ring->tamanho_item, origem, primeiro * ring->tamanho_item);
+    if(n > primeiro)
+        memcpy(ring->buffer, origem + primeiro * ring->tamanho_item, (n - primeiro) * ring->tamanho_item);
+}
+
+static void copiar_do_ring(ring_spsc_t *ring, uint32_t inicio, uint8_t *destino, uint32_t n)
+{
+    uint32_t pos = inicio & ring->mascara;
+    uint32_t ate_fim = ring->mascara + 1 - pos;
+    uint32_t primeiro = n < ate_fim ? n : ate_fim;
+
+    memcpy(destino, ring->buffer + pos * ring->tamanho_item, primeiro * ring->tamanho_item);
+    if(n > primeiro)
+        memcpy(destino + primeiro * ring->tamanho_item, ring->buffer, (n - primeiro) * ring->tamanho_item);
+}
+
+// ==========================================
+bool ring_spsc_init(ring_spsc_t *ring, void *buffer, uint32_t capacidade, uint32_t tamanho_item)
+{
+    if(capacidade == 0 || (capacidade & (capacidade - 1)) != 0 || buffer == NULL || tamanho_item == 0)
+        return false; // Capacidade precisa ser potência de 2
+
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    ring->tail_cache = 0;
+    ring->head_cache = 0;
+    ring->buffer = buffer;
+    ring->mascara = capacidade - 1;
+    ring->tamanho_item = tamanho_item;
+    return true;
+}
+
+// ==========================================
+// Lado do produtor
+uint32_t ring_spsc_push_lote(ring_spsc_t *ring, const void *itens, uint32_t n)
+{
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    uint32_t livre = ring->mascara + 1 - (head - ring->tail_cache);
+
+    if(livre < n)
+    {
+        // Só relê o tail do consumidor quando a cópia local indica falta de espaço
+        ring->tail_cache = atomic_load_explicit(&ring->tail, memory_order_acquire);
+        livre = ring->mascara + 1 - (head - ring->tail_cache);
+    }
+
+    if(n > livre)
+        n = livre;
+    if(n == 0)
+        return 0;
+
+    copiar_para_ring(ring, head, itens, n);
+    atomic_store_explicit(&ring->head, head + n, memory_order_release); // Publica os itens
+    return n;
+}
+
+bool ring_spsc_push(ring_spsc_t *ring, const void *item)
+{
+    return ring_spsc_push_lote(ring, item, 1) == 1;
+}
+
+// ==========================================
+// Lado do consumidor
+uint32_t ring_spsc_pop_lote(ring_spsc_t *ring, void *itens, uint32_t n)
+{
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    uint32_t disponivel = ring->head_cache - tail;
+
+    if(disponivel < n)
+    {
+        // Só relê o head do produtor quando a cópia local não basta
+        ring->head_cache = atomic_load_explicit(&ring->head, memory_order_acquire);
+        disponivel = ring->head_cache - tail;
+    }
+
+    if(n > disponivel)
+        n = disponivel;
+    if(n == 0)
+        return 0;
+
+    copiar_do_ring(ring, tail, itens, n);
+    atomic_store_explicit(&ring->tail, tail + n, memory_order_release); // Libera as posições
+    return n;
+}
+
+bool ring_spsc_pop(ring_spsc_t *ring, void *item)
+{
+    return ring_spsc_pop_lote(ring, item, 1) == 1;
+}
+
+const void *ring_spsc_frente(ring_spsc_t *ring)
+{
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+
+    if(ring->head_cache == tail)
+        ring->head_cache = atomic_load_explicit(&ring->head, memory_order_acquire);
+    if(ring->head_cache == tail)
+        return NULL;
+    return ring->buffer + (tail & ring->mascara) * ring->tamanho_item;
+}
+
+void ring_spsc_limpar(ring_spsc_t *ring)
+{
+    // O consumidor avança o tail até o head atual; itens publicados depois continuam válidos
+    ring->head_cache = atomic_load_explicit(&ring->head, memory_order_acquire);
+    atomic_store_explicit(&ring->tail, ring->head_cache, memory_order_release);
+}
+
+uint32_t ring_spsc_ocupacao(const ring_spsc_t *ring)
+{
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    return head - tail;
+}
@@ -0,0 +1,68 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Ring buffer lock-free de um produtor e um consumidor (SPSC)
+ * Índices head/tail atômicos, válidos entre os dois núcleos do ESP32.
+ * Os itens têm tamanho fixo (como em xQueueCreate) e são copiados com memcpy.
+ * Apenas UMA task pode chamar push e apenas UMA task pode chamar pop.
+ */
+
+#pragma once
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Tamanho da linha de cache; head e tail ficam em linhas separadas
+// para que produtor e consumidor não disputem a mesma linha.
+#define RING_LINHA_CACHE 32
+
+typedef struct
+{
+    // Lado do produtor
+    _Alignas(RING_LINHA_CACHE) atomic_uint head; // Próxima posição a escrever
+    uint32_t tail_cache;                         // Cópia local do tail (evita leituras atômicas)
+
+    // Lado do consumidor
+    _Alignas(RING_LINHA_CACHE) atomic_uint tail; // Próxima posição a ler
+    uint32_t head_cache;                         // Cópia local do head
+
+    // Constantes após a inicialização
+    _Alignas(RING_LINHA_CACHE) uint8_t *buffer;
+    uint32_t mascara;     // capacidade - 1 (capacidade é potência de 2)
+    uint32_t tamanho_item;
+} ring_spsc_t;
+
+// Inicializa o ring sobre um buffer de capacidade * tamanho_item bytes.
+// Retorna false se a capacidade não for potência de 2.
+bool ring_spsc_init(ring_spsc_t *ring, void *buffer, uint32_t capacidade, uint32_t tamanho_item);
+
+// Produtor: insere um item. Retorna false se o ring estiver cheio.
+bool ring_spsc_push(ring_spsc_t *ring, const void *item);
+
+// Produtor: insere até n itens contíguos. Retorna quantos foram inseridos.
+uint32_t ring_spsc_push_lote(ring_spsc_t *ring, const void *itens, uint32_t n);
+
+// Consumidor: remove um item. Retorna false se o ring estiver vazio.
+bool ring_spsc_pop(ring_spsc_t *ring, void *item);
+
+// Consumidor: remove até n itens. Retorna quantos foram removidos.
+uint32_t ring_spsc_pop_lote(ring_spsc_t *ring, void *itens, uint32_t n);
+
+// Consumidor: item mais antigo sem removê-lo, ou NULL se o ring estiver vazio.
+// O ponteiro vale até o próximo pop/limpar.
+const void *ring_spsc_frente(ring_spsc_t *ring);
+
+// Consumidor: descarta todo o conteúdo (equivalente a xQueueReset).
+void ring_spsc_limpar(ring_spsc_t *ring);
+
+// Qualquer lado: número aproximado de itens armazenados.
+uint32_t ring_spsc_ocupacao(const ring_spsc_t *ring);
+
+static inline uint32_t ring_spsc_capacidade(const ring_spsc_t *ring)
+{
+    return ring->mascara + 1;
+}
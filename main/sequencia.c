@@ -0,0 +1,136 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Implementação do detector de sequência
+ * Bit i de 'vistos' indica que a sequência (maior - i) já chegou. As
+ * diferenças são calculadas em aritmética de 32 bits com sinal, o que tolera
+ * a volta do contador.
+ */
+
+#include <string.h>
+#include "sequencia.h"
+#include "log_async.h"
+
+typedef struct
+{
+    bool iniciado;
+    uint32_t primeiro;
+    uint32_t maior;
+    uint64_t vistos;
+    seq_stats_t stats;
+} detector_t;
+
+static detector_t detectores[SEQ_MAX_ORIGENS];
+static uint32_t origem_invalida;
+
+void sequencia_init(void)
+{
+    memset(detectores, 0, sizeof(detectores));
+    origem_invalida = 0;
+}
+
+seq_evento_t sequencia_registrar(uint16_t origem, uint32_t seq)
+{
+    if(origem >= SEQ_MAX_ORIGENS)
+    {
+        origem_invalida++;
+        return SEQ_FORA_JANELA;
+    }
+
+    detector_t *d = &detectores[origem];
+    d->stats.recebidos++;
+
+    if(!d->iniciado)
+    {
+        d->iniciado = true;
+        d->primeiro = d->maior = seq;
+        d->vistos = 1;
+        d->stats.esperados = 1;
+        return SEQ_OK;
+    }
+
+    int32_t avanco = (int32_t)(seq - d->maior);
+    if(avanco > 0)
+    {
+        d->vistos = avanco >= SEQ_JANELA ? 1 : (d->vistos << avanco) | 1;
+        d->maior = seq;
+        d->stats.esperados = seq - d->primeiro + 1;
+        if(avanco == 1)
+            return SEQ_OK;
+        d->stats.perdidos += avanco - 1;
+        return SEQ_LACUNA;
+    }
+
+    uint32_t atraso = (uint32_t)-avanco;
+    if(atraso >= SEQ_JANELA)
+    {
+        d->stats.fora_janela++;
+        return SEQ_FORA_JANELA;
+    }
+    if(d->vistos & (1ULL << atraso))
+    {
+        d->stats.duplicados++;
+        return SEQ_DUPLICADO;
+    }
+    d->vistos |= 1ULL << atraso;
+    d->stats.reordenados++;
+
+    int32_t antes_do_primeiro = (int32_t)(d->primeiro - seq);
+    if(antes_do_primeiro > 0)
+    {
+        // Anterior à primeira vista (ex.: urgente entregue antes do volume
+        // atrasado): nunca foi lacuna. A origem passa a começar nela e o que
+        // ficou entre as duas vira lacuna.
+        d->stats.perdidos += (uint32_t)antes_do_primeiro - 1;
+        d->primeiro = seq;
+        d->stats.esperados = d->maior - d->primeiro + 1;
+        return SEQ_REORDENADO;
+    }
+    d->stats.perdidos--; // Entre a primeira e a maior: era uma lacuna contada como perda
+    return SEQ_REORDENADO;
+}
+
+void sequencia_estatisticas(seq_stats_t *s)
+{
+    memset(s, 0, sizeof(*s));
+    for(int i = 0; i < SEQ_MAX_ORIGENS; i++)
+    {
+        const seq_stats_t *o = &detectores[i].stats;
+        s->recebidos += o->recebidos;
+        s->esperados += o->esperados;
+        s->perdidos += o->perdidos;
+        s->duplicados += o->duplicados;
+        s->reordenados += o->reordenados;
+        s->fora_janela += o->fora_janela;
+    }
+}
+
+const char *sequencia_nome(seq_evento_t evento)
+{
+    switch(evento)
+    {
+    case SEQ_OK:          return "ok";
+    case SEQ_LACUNA:      return "lacuna";
+    case SEQ_DUPLICADO:   return "duplicado";
+    case SEQ_REORDENADO:  return "reordenado";
+    case SEQ_FORA_JANELA: return "fora da janela";
+    }
+    return "?";
+}
+
+void sequencia_relatorio(void)
+{
+    seq_stats_t s;
+    sequencia_estatisticas(&s);
+
+    uint32_t permil = s.esperados > 0 ? (uint32_t)((uint64_t)s.perdidos * 1000 / s.esperados) : 0;
+    // Duas linhas: com contadores de 5+ dígitos uma só passaria de LOG_TAM_LINHA
+    log_printf("   - Sequência: %lu recebidos, %lu perdidos de %lu (%lu.%lu%%)\n",
+               s.recebidos, s.perdidos, s.esperados, permil / 10, permil % 10);
+    log_printf("   - Sequência: %lu duplicados, %lu reordenados, %lu fora da janela\n",
+               s.duplicados, s.reordenados, s.fora_janela);
+    if(origem_invalida > 0)
+        log_printf("   - Sequência: %lu itens com origem inválida\n", origem_invalida);
+}
@@ -0,0 +1,53 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Detector de lacunas, duplicatas e reordenação na Task2
+ * Para cada origem guarda a maior sequência vista e um mapa de 64 bits das
+ * sequências recentes abaixo dela; cada registro é O(1). Um item atrasado que
+ * preenche uma lacuna já contada deixa de ser perda e passa a reordenado.
+ * Escrito só pela task consumidora; a Task4 lê palavras de 32 bits.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sistema_config.h"
+
+#define SEQ_JANELA 64 // Sequências abaixo da maior que ainda podem ser classificadas
+
+typedef enum
+{
+    SEQ_OK,          // Próxima esperada
+    SEQ_LACUNA,      // Pulou sequências (contadas como perdidas)
+    SEQ_DUPLICADO,   // Já recebida
+    SEQ_REORDENADO,  // Chegou depois de uma maior (recupera uma perda)
+    SEQ_FORA_JANELA, // Atrasada demais para classificar
+} seq_evento_t;
+
+typedef struct
+{
+    uint32_t recebidos;
+    uint32_t esperados;   // Sequências do primeiro ao maior (únicos + perdidos)
+    uint32_t perdidos;
+    uint32_t duplicados;
+    uint32_t reordenados;
+    uint32_t fora_janela;
+} seq_stats_t;
+
+// Zera os detectores de todas as origens.
+void sequencia_init(void);
+
+// Consumidor: classifica a sequência recebida de 'origem' e atualiza as estatísticas.
+seq_evento_t sequencia_registrar(uint16_t origem, uint32_t seq);
+
+// Soma as estatísticas de todas as origens.
+void sequencia_estatisticas(seq_stats_t *stats);
+
+// Nome curto do evento.
+const char *sequencia_nome(seq_evento_t evento);
+
+// Loga a taxa de perda e os demais contadores (uso no logger).
+void sequencia_relatorio(void);
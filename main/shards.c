@@ -0,0 +1,91 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Implementação da fila particionada
+ * A mescla por tempo compara só as frentes dos shards: um item publicado
+ * depois da leitura pode ser mais antigo que o último entregue, então a ordem
+ * é a melhor possível no instante do pop, não uma ordenação global.
+ */
+
+#include "shards.h"
+
+bool shards_init(shards_t *s, fila_item_t *buffer, uint32_t n, uint32_t capacidade, uint32_t mescla)
+{
+    if(n == 0 || n > SHARDS_MAX)
+        return false;
+
+    for(uint32_t k = 0; k < n; k++)
+    {
+        if(!ring_spsc_init(&s->aneis[k], buffer + k * capacidade, capacidade, sizeof(fila_item_t)))
+            return false;
+    }
+    s->n = n;
+    s->mescla = mescla;
+    s->proximo = 0;
+    return true;
+}
+
+// ==========================================
+// Rodízio: cada shard entrega o que tiver (até o que falta) e a vez passa ao seguinte
+static uint32_t pop_rodizio(shards_t *s, fila_item_t *itens, uint32_t max)
+{
+    uint32_t lidos = 0;
+
+    for(uint32_t i = 0; i < s->n && lidos < max; i++)
+    {
+        uint32_t k = s->proximo;
+        s->proximo = k + 1 == s->n ? 0 : k + 1;
+        lidos += ring_spsc_pop_lote(&s->aneis[k], itens + lidos, max - lidos);
+    }
+    return lidos;
+}
+
+// Tempo: a cada item, a frente com menor t_producao (comparação com volta do contador)
+static uint32_t pop_tempo(shards_t *s, fila_item_t *itens, uint32_t max)
+{
+    uint32_t lidos = 0;
+
+    while(lidos < max)
+    {
+        int escolhido = -1;
+        uint32_t t_min = 0;
+
+        for(uint32_t k = 0; k < s->n; k++)
+        {
+            const fila_item_t *frente = ring_spsc_frente(&s->aneis[k]);
+            if(frente != NULL && (escolhido < 0 || (int32_t)(frente->t_producao - t_min) < 0))
+            {
+                escolhido = k;
+                t_min = frente->t_producao;
+            }
+        }
+        if(escolhido < 0)
+            break;
+        ring_spsc_pop(&s->aneis[escolhido], &itens[lidos++]);
+    }
+    return lidos;
+}
+
+uint32_t shards_pop_lote(shards_t *s, fila_item_t *itens, uint32_t max)
+{
+    if(s->n == 1)
+        return ring_spsc_pop_lote(&s->aneis[0], itens, max);
+    return s->mescla == FILA_MESCLA_TEMPO ? pop_tempo(s, itens, max) : pop_rodizio(s, itens, max);
+}
+
+// ==========================================
+void shards_limpar(shards_t *s)
+{
+    for(uint32_t k = 0; k < s->n; k++)
+        ring_spsc_limpar(&s->aneis[k]);
+}
+
+uint32_t shards_ocupacao(const shards_t *s)
+{
+    uint32_t total = 0;
+    for(uint32_t k = 0; k < s->n; k++)
+        total += ring_spsc_ocupacao(&s->aneis[k]);
+    return total;
+}
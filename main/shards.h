@@ -0,0 +1,57 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Fila particionada de vários produtores e um consumidor
+ * Cada produtor tem seu próprio ring SPSC (shard): não há trava nem linha de
+ * cache disputada entre produtores. O consumidor mescla os shards em rodízio
+ * ou pelo item mais antigo (FILA_MESCLA_*, sistema_config.h).
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ring_spsc.h"
+#include "transporte.h"
+
+#define SHARDS_MAX 16
+
+typedef struct
+{
+    ring_spsc_t aneis[SHARDS_MAX];
+    uint32_t n;
+    uint32_t mescla;  // FILA_MESCLA_*
+    uint32_t proximo; // Próximo shard do rodízio (lado do consumidor)
+} shards_t;
+
+// Divide 'buffer' (n * capacidade itens) em n shards. Retorna false se n for
+// maior que SHARDS_MAX ou a capacidade não for potência de 2.
+bool shards_init(shards_t *s, fila_item_t *buffer, uint32_t n, uint32_t capacidade, uint32_t mescla);
+
+// Produtor dono do shard: insere um item. Retorna false se o shard estiver cheio.
+static inline bool shards_push(shards_t *s, uint32_t shard, const fila_item_t *item)
+{
+    return ring_spsc_push(&s->aneis[shard], item);
+}
+
+// Produtor dono do shard: insere até n itens. Retorna quantos foram inseridos.
+static inline uint32_t shards_push_lote(shards_t *s, uint32_t shard, const fila_item_t *itens, uint32_t n)
+{
+    return ring_spsc_push_lote(&s->aneis[shard], itens, n);
+}
+
+// Consumidor: retira até 'max' itens da mescla. Retorna quantos foram lidos.
+uint32_t shards_pop_lote(shards_t *s, fila_item_t *itens, uint32_t max);
+
+static inline bool shards_pop(shards_t *s, fila_item_t *item)
+{
+    return shards_pop_lote(s, item, 1) == 1;
+}
+
+// Consumidor: descarta o conteúdo de todos os shards.
+void shards_limpar(shards_t *s);
+
+// Qualquer lado: itens armazenados em todos os shards (aproximado).
+uint32_t shards_ocupacao(const shards_t *s);
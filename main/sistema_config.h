@@ -0,0 +1,455 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Opções de compilação do sistema de dados robusto
+ * Todas as opções podem ser sobrescritas com -D no CMakeLists.txt do componente,
+ * por exemplo: target_compile_definitions(${COMPONENT_LIB} PRIVATE FILA_TRANSPORTE=1)
+ */
+
+#pragma once
+
+// ==========================================
+// Modo de produção da Task1
+// PERIODICO:  um valor por TASK1_PERIODO_MS (1 Hz)
+// AMOSTRAGEM: amostras geradas por gptimer a AMOSTRAGEM_FREQ_HZ e enviadas em lote (amostragem.c)
+#define TASK1_MODO_PERIODICO  0
+#define TASK1_MODO_AMOSTRAGEM 1
+
+#ifndef TASK1_MODO
+#define TASK1_MODO TASK1_MODO_PERIODICO
+#endif
+
+#ifndef AMOSTRAGEM_FREQ_HZ
+#define AMOSTRAGEM_FREQ_HZ 10000 // Até ~50 kHz
+#endif
+
+#ifndef AMOSTRAGEM_LOTE
+#define AMOSTRAGEM_LOTE 64 // Amostras por notificação da ISR para a Task1
+#endif
+
+#ifndef AMOSTRAGEM_RING_CAP
+#define AMOSTRAGEM_RING_CAP 512 // Ring entre a ISR e a Task1 (potência de 2)
+#endif
+
+// Acúmulo na Task1 (modo AMOSTRAGEM, lote.c): descarrega com LOTE_N amostras
+// ou quando a mais antiga esperou LOTE_T_US, o que vier antes
+#ifndef LOTE_N
+#define LOTE_N 32
+#endif
+
+#ifndef LOTE_T_US
+#define LOTE_T_US 5000
+#endif
+
+// Mensagens por amostra ([FILA OK] ...) só fazem sentido na taxa de 1 Hz
+#ifndef LOG_POR_AMOSTRA
+#define LOG_POR_AMOSTRA (TASK1_MODO == TASK1_MODO_PERIODICO)
+#endif
+
+// ==========================================
+// Transporte entre Task1 e Task2
+#define FILA_TRANSPORTE_QUEUE 0 // Fila FreeRTOS (xQueueSend / xQueueReceive)
+#define FILA_TRANSPORTE_RING  1 // Ring buffer SPSC lock-free (ring_spsc.c)
+#define FILA_TRANSPORTE_NOTIFICACAO 2 // Caixa de um item + notificação da task; filas FreeRTOS de reserva
+
+// O ring já acorda o consumidor por notificação só quando ele está bloqueado;
+// entre os modos com filas FreeRTOS, bench_notificacao indica QUEUE ou NOTIFICACAO
+#ifndef FILA_TRANSPORTE
+#define FILA_TRANSPORTE FILA_TRANSPORTE_RING
+#endif
+
+#ifndef FILA_CAPACIDADE
+#if TASK1_MODO == TASK1_MODO_AMOSTRAGEM
+#define FILA_CAPACIDADE 256 // Absorve alguns lotes da amostragem de alta taxa
+#else
+#define FILA_CAPACIDADE 16 // Posições da fila (potência de 2 quando usar o ring)
+#endif
+#endif
+
+// Produtores: a Task1 e PRODUTORES - 1 tasks extras, alternadas entre os
+// núcleos. Cada produtor escreve no seu shard (FILA_CAPACIDADE posições) e a
+// Task2 consome a mescla: ordem de chegada pelo QueueSet no modo QUEUE,
+// rodízio ou menor t_producao no modo RING (shards.c)
+#ifndef PRODUTORES
+#define PRODUTORES 1
+#endif
+
+#define FILA_MESCLA_RODIZIO 0 // Um shard por vez, a partir do seguinte ao último lido
+#define FILA_MESCLA_TEMPO   1 // Frente mais antiga entre os shards (t_producao)
+
+#ifndef FILA_MESCLA
+#define FILA_MESCLA FILA_MESCLA_RODIZIO
+#endif
+
+// Faixas de prioridade: cada faixa tem suas próprias filas/rings e a Task2
+// escolhe a faixa do próximo item pelo escalonador (faixas.c). A faixa 0
+// (volume) é a padrão de um item zerado; a urgente recebe os valores de alarme.
+#define FAIXA_VOLUME  0
+#define FAIXA_URGENTE 1
+
+// Opcional: com 2 faixas um urgente ultrapassa os itens de volume da mesma
+// origem, e o detector de sequência conta essas ultrapassagens como reordenação.
+#ifndef FAIXAS
+#define FAIXAS 1 // 1: uma única fila FIFO (comportamento original); 2: volume + urgente
+#endif
+
+#define FAIXAS_ESTRITA   0 // Sempre a faixa mais urgente com dados (o volume pode esperar indefinidamente)
+#define FAIXAS_PONDERADA 1 // Rodízio com peso: até FAIXA_PESO_URGENTE urgentes por item de volume
+
+#ifndef FAIXAS_ESCALONAMENTO
+#define FAIXAS_ESCALONAMENTO FAIXAS_ESTRITA
+#endif
+
+#ifndef FAIXA_PESO_URGENTE
+#define FAIXA_PESO_URGENTE 4
+#endif
+
+#ifndef FAIXA_URGENTE_CAPACIDADE
+#define FAIXA_URGENTE_CAPACIDADE 8 // Posições da faixa urgente por produtor (potência de 2 no ring)
+#endif
+
+#ifndef FAIXA_ALARME_CADA
+#define FAIXA_ALARME_CADA 10 // Produtores: um valor em N é de alarme e vai pela faixa urgente
+#endif
+
+#if FAIXAS < 1 || FAIXAS > 2
+#error "FAIXAS deve ser 1 ou 2"
+#endif
+
+// Posições de todas as filas do transporte (produtores x faixas)
+#define FILA_POSICOES (PRODUTORES * (FILA_CAPACIDADE + (FAIXAS > 1 ? FAIXA_URGENTE_CAPACIDADE : 0)))
+
+#ifndef PRODUTOR_PILHA
+#define PRODUTOR_PILHA 4096 // Pilha de cada produtor extra (sem log por amostra)
+#endif
+
+// ==========================================
+// Contrapressão: o que a Task1 faz com a fila cheia (contrapressao.c)
+#define CONTRAPRESSAO_DESCARTAR_NOVO   0 // Perde o valor novo (comportamento original)
+#define CONTRAPRESSAO_DESCARTAR_ANTIGO 1 // Mantém os mais recentes, perde o mais antigo retido
+#define CONTRAPRESSAO_BLOQUEAR         2 // Espera espaço até um prazo
+#define CONTRAPRESSAO_COALESCER        3 // Guarda só o valor mais recente
+#define CONTRAPRESSAO_TRANSBORDO       4 // Reserva secundária em ordem
+
+#ifndef CONTRAPRESSAO_POLITICA
+#define CONTRAPRESSAO_POLITICA CONTRAPRESSAO_DESCARTAR_NOVO
+#endif
+
+#ifndef CONTRAPRESSAO_JANELA
+#define CONTRAPRESSAO_JANELA 4 // Valores recentes mantidos em DESCARTAR_ANTIGO
+#endif
+
+#ifndef CONTRAPRESSAO_PRAZO_MS
+#define CONTRAPRESSAO_PRAZO_MS 100 // Espera máxima em BLOQUEAR
+#endif
+
+#ifndef CONTRAPRESSAO_RESERVA
+#define CONTRAPRESSAO_RESERVA 64 // Posições da reserva secundária em TRANSBORDO (>= JANELA)
+#endif
+
+// ==========================================
+// Controle de taxa da Task1 (controle_taxa.c, modo periódico)
+// Malha fechada sobre a ocupação da faixa de volume: o período encurta enquanto
+// a fila fica abaixo da metade do alvo e dobra (sem ficar mais rápido que a
+// vazão medida do consumidor) quando a ocupação alcança o alvo, antes de a
+// fila encher e a contrapressão descartar valores.
+// 0: período fixo de TASK1_PERIODO_MS (comportamento original)
+#ifndef CONTROLE_TAXA
+#define CONTROLE_TAXA 0
+#endif
+
+#ifndef CONTROLE_OCUPACAO_ALVO_PCT
+#define CONTROLE_OCUPACAO_ALVO_PCT 50 // Ocupação máxima desejada da faixa de volume
+#endif
+
+#ifndef CONTROLE_PERIODO_MIN_MS
+#define CONTROLE_PERIODO_MIN_MS 10 // Um tick com CONFIG_FREERTOS_HZ=100
+#endif
+
+#if CONTROLE_OCUPACAO_ALVO_PCT < 1 || CONTROLE_OCUPACAO_ALVO_PCT > 99
+#error "CONTROLE_OCUPACAO_ALVO_PCT deve estar entre 1 e 99"
+#endif
+
+// ==========================================
+// Pool de trabalhadores (trabalhadores.c): com TRABALHADORES > 0 a Task2 só
+// recebe, confere a sequência e distribui; o processamento de cada amostra
+// roda nos trabalhadores, alternados entre os núcleos, com roubo de trabalho.
+// 0: a Task2 processa cada amostra no próprio laço (comportamento original)
+#ifndef TRABALHADORES
+#define TRABALHADORES 0
+#endif
+
+#ifndef TRABALHADOR_PILHA
+#define TRABALHADOR_PILHA 4096
+#endif
+
+#ifndef TRABALHO_DEQUE_CAP
+#define TRABALHO_DEQUE_CAP 16 // Itens por deque de trabalhador
+#endif
+
+#ifndef TRABALHO_CICLOS
+#define TRABALHO_CICLOS 0 // Carga sintética por amostra (ciclos de CPU), para dimensionar o pool
+#endif
+
+#ifndef TRABALHO_ESPERA_MS
+#define TRABALHO_ESPERA_MS 10 // Sono máximo de um trabalhador ocioso antes de tentar roubar de novo
+#endif
+
+// Origens distintas acompanhadas pelo detector de sequência (sequencia.c)
+#ifndef SEQ_MAX_ORIGENS
+#define SEQ_MAX_ORIGENS 16
+#endif
+
+#if PRODUTORES < 1 || PRODUTORES + 1 > SEQ_MAX_ORIGENS
+#error "PRODUTORES deve ficar entre 1 e SEQ_MAX_ORIGENS - 1"
+#endif
+
+// ==========================================
+// Transporte sem cópia (bloco_dados.c): a Task1 preenche um quadro de
+// BLOCO_PAYLOAD bytes de um pool e só o ponteiro trafega na fila
+#ifndef FILA_ZERO_COPIA
+#define FILA_ZERO_COPIA 0
+#endif
+
+#ifndef BLOCO_PAYLOAD
+#define BLOCO_PAYLOAD 1024 // Bytes de dados por quadro
+#endif
+
+#ifndef BLOCO_QUANTIDADE
+#define BLOCO_QUANTIDADE (FILA_POSICOES + 4) // Filas cheias + blocos em uso nas tasks
+#endif
+
+#ifndef BLOCO_IDADE_MAX_MS
+#define BLOCO_IDADE_MAX_MS 5000 // Bloco em uso há mais tempo que isso é considerado vazado
+#endif
+
+// ==========================================
+// Afinidade de núcleo e prioridades das tasks
+// LIVRE:    nenhuma task fixada (o escalonador distribui entre os núcleos)
+// DADOS_1:  Task1 e Task2 no núcleo 1; supervisão, logger e log no núcleo 0
+// CRUZADO:  Task1 no núcleo 0 e Task2 no núcleo 1; supervisão e log no núcleo 0
+// Cada TASKn_NUCLEO pode ser sobrescrito individualmente (tskNO_AFFINITY = livre)
+#define PERFIL_AFINIDADE_LIVRE   0
+#define PERFIL_AFINIDADE_DADOS_1 1
+#define PERFIL_AFINIDADE_CRUZADO 2
+
+#ifndef PERFIL_AFINIDADE
+#define PERFIL_AFINIDADE PERFIL_AFINIDADE_LIVRE
+#endif
+
+#if PERFIL_AFINIDADE == PERFIL_AFINIDADE_LIVRE
+#define PERFIL_NUCLEO_PRODUTOR   tskNO_AFFINITY
+#define PERFIL_NUCLEO_CONSUMIDOR tskNO_AFFINITY
+#define PERFIL_NUCLEO_SUPERVISAO tskNO_AFFINITY
+#elif PERFIL_AFINIDADE == PERFIL_AFINIDADE_DADOS_1
+#define PERFIL_NUCLEO_PRODUTOR   1
+#define PERFIL_NUCLEO_CONSUMIDOR 1
+#define PERFIL_NUCLEO_SUPERVISAO 0
+#elif PERFIL_AFINIDADE == PERFIL_AFINIDADE_CRUZADO
+#define PERFIL_NUCLEO_PRODUTOR   0
+#define PERFIL_NUCLEO_CONSUMIDOR 1
+#define PERFIL_NUCLEO_SUPERVISAO 0
+#else
+#error "PERFIL_AFINIDADE inválido"
+#endif
+
+#ifndef TASK1_NUCLEO
+#define TASK1_NUCLEO PERFIL_NUCLEO_PRODUTOR
+#endif
+#ifndef TASK2_NUCLEO
+#define TASK2_NUCLEO PERFIL_NUCLEO_CONSUMIDOR
+#endif
+#ifndef TASK3_NUCLEO
+#define TASK3_NUCLEO PERFIL_NUCLEO_SUPERVISAO
+#endif
+#ifndef TASK4_NUCLEO
+#define TASK4_NUCLEO PERFIL_NUCLEO_SUPERVISAO
+#endif
+#ifndef LOG_NUCLEO
+#define LOG_NUCLEO PERFIL_NUCLEO_SUPERVISAO
+#endif
+
+#ifndef TASK1_PRIORIDADE
+#define TASK1_PRIORIDADE 5
+#endif
+#ifndef TASK2_PRIORIDADE
+#define TASK2_PRIORIDADE 5
+#endif
+#ifndef TASK3_PRIORIDADE
+#define TASK3_PRIORIDADE 5
+#endif
+#ifndef TASK4_PRIORIDADE
+#define TASK4_PRIORIDADE 5
+#endif
+
+// ==========================================
+// Perfil de alocação na inicialização
+// 0: tasks e fila criadas no heap (xTaskCreate, xQueueCreate...)
+// 1: memória reservada estaticamente (xTaskCreateStatic, xQueueCreateStatic):
+//    a criação não depende do heap e não falha
+#ifndef ALOCACAO_ESTATICA
+#define ALOCACAO_ESTATICA 0
+#endif
+
+// Pilhas das tasks (bytes). Com PILHAS_GERADAS=1 os tamanhos vêm do
+// pilhas_geradas.h produzido pelo perfil de pilhas (gerar_pilhas.py)
+#ifndef PILHAS_GERADAS
+#define PILHAS_GERADAS 0
+#endif
+
+#if PILHAS_GERADAS
+#include "pilhas_geradas.h"
+#endif
+
+#ifndef TASK1_PILHA
+#define TASK1_PILHA 8192
+#endif
+
+#ifndef TASK2_PILHA
+#define TASK2_PILHA 8192
+#endif
+
+#ifndef TASK3_PILHA
+#define TASK3_PILHA 8192
+#endif
+
+#ifndef TASK4_PILHA
+#define TASK4_PILHA 8192
+#endif
+
+#ifndef LOG_PILHA
+#define LOG_PILHA 4096
+#endif
+
+// Telemetria do heap (heap_uso.c): maior bloco que os pipelines precisam
+// alocar e horizonte (em relatórios do logger) do aviso de tendência
+#ifndef HEAP_BLOCO_NECESSARIO
+#define HEAP_BLOCO_NECESSARIO 8192 // Pilha de uma task no perfil com heap
+#endif
+
+#ifndef HEAP_TENDENCIA_CICLOS
+#define HEAP_TENDENCIA_CICLOS 20
+#endif
+
+// Perfil de pilhas (perfil_pilha.c): carga de estresse cíclica e emissão dos
+// tamanhos recomendados a cada PERFIL_PILHAS_DURACAO_S
+#ifndef PERFIL_PILHAS
+#define PERFIL_PILHAS 0
+#endif
+
+#ifndef PERFIL_PILHAS_DURACAO_S
+#define PERFIL_PILHAS_DURACAO_S 120 // 3 ciclos de estresse
+#endif
+
+#ifndef PERFIL_PILHAS_CICLO_S
+#define PERFIL_PILHAS_CICLO_S 40
+#endif
+
+#ifndef PERFIL_PILHAS_MARGEM_PCT
+#define PERFIL_PILHAS_MARGEM_PCT 25
+#endif
+
+// ==========================================
+// Estado preservado entre resets (estado_rtc.c): itens da fila salvos no
+// esp_restart() e reenviados no boot (memória RTC lenta: 16 bytes por item)
+#ifndef ESTADO_RTC_PENDENTES
+#define ESTADO_RTC_PENDENTES 16
+#endif
+
+// ==========================================
+// Injeção de falha para exercitar a escada de recuperação da Task2: a Task1
+// (modo periódico) continua viva e alimentando o WDT, mas para de produzir
+// FALHA_APOS_S depois de iniciar. TRANSITORIA some quando a task é recriada;
+// PERSISTENTE sobrevive à recriação e leva ao reset do chip.
+#define FALHA_NENHUMA           0
+#define FALHA_TASK1_TRANSITORIA 1
+#define FALHA_TASK1_PERSISTENTE 2
+
+#ifndef INJETAR_FALHA
+#define INJETAR_FALHA FALHA_NENHUMA
+#endif
+
+#ifndef FALHA_APOS_S
+#define FALHA_APOS_S 30
+#endif
+
+// ==========================================
+// Log assíncrono (log_async.c)
+#ifndef LOG_CAPACIDADE
+#define LOG_CAPACIDADE 64 // Mensagens no ring (potência de 2)
+#endif
+
+#ifndef LOG_TAM_LINHA
+#define LOG_TAM_LINHA 112 // Bytes por mensagem formatada
+#endif
+
+#ifndef LOG_PERIODO_DRENO_MS
+#define LOG_PERIODO_DRENO_MS 20 // Intervalo entre drenagens do ring
+#endif
+
+#ifndef LOG_PRIORIDADE
+#define LOG_PRIORIDADE 1 // Abaixo de todas as tasks do sistema
+#endif
+
+// Formato no console: texto formatado no dispositivo ou registros binários
+// decodificados no host por log_decoder.py (log_binario.c)
+#define LOG_MODO_TEXTO    0
+#define LOG_MODO_BINARIO  1
+
+#ifndef LOG_MODO
+#define LOG_MODO LOG_MODO_TEXTO
+#endif
+
+#ifndef LOG_BIN_MAX_IDS
+#define LOG_BIN_MAX_IDS 128 // IDs de formato (até 127 cabem em um byte de varint)
+#endif
+
+#ifndef LOG_BIN_REANUNCIO_MS
+#define LOG_BIN_REANUNCIO_MS 10000 // Reenvio da tabela de formatos para decodificadores tardios
+#endif
+
+// ==========================================
+// Estatísticas de execução no logger (monitor_cpu.c)
+#ifndef MONITOR_MAX_TASKS
+#define MONITOR_MAX_TASKS 24 // Tasks acompanhadas por retrato
+#endif
+
+// ==========================================
+// Benchmarks executados no boot, antes da criação das tasks
+#ifndef EXECUTAR_BENCHMARKS
+#define EXECUTAR_BENCHMARKS 0
+#endif
+
+#ifndef BENCH_ITENS
+#define BENCH_ITENS 100000 // Itens transferidos por rodada de benchmark
+#endif
+
+#ifndef BENCH_PINGUE
+#define BENCH_PINGUE 10000 // Idas e voltas no benchmark de latência de handoff
+#endif
+
+#ifndef BENCH_ZC_ITENS
+#define BENCH_ZC_ITENS 10000 // Quadros por tamanho no benchmark cópia x zero-copy
+#endif
+
+#ifndef BENCH_FANIN_ITENS
+#define BENCH_FANIN_ITENS 32000 // Total por rodada do benchmark de 1 a 16 produtores
+#endif
+
+#ifndef BENCH_TRABALHO_ITENS
+#define BENCH_TRABALHO_ITENS 4000 // Itens por rodada do benchmark do pool de trabalhadores
+#endif
+
+#ifndef BENCH_TRABALHO_CICLOS
+#define BENCH_TRABALHO_CICLOS 20000 // Custo base de cada item nesse benchmark (125 us a 160 MHz)
+#endif
+
+#ifndef BENCH_FAIXAS_ITENS
+#define BENCH_FAIXAS_ITENS 5000 // Itens de volume por rodada do benchmark de faixas
+#endif
+
+#ifndef SOAK_CICLOS
+#define SOAK_CICLOS 2000000 // Ciclos alocar/liberar no soak do pool de blocos
+#endif
@@ -0,0 +1,255 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Implementação do pool de trabalhadores
+ * O alimentador e o trabalhador que vai dormir usam o mesmo protocolo do
+ * transporte em ring (flag + barreira + nova verificação); a espera tem prazo
+ * de TRABALHO_ESPERA_MS, que também alimenta o WDT e limita um despertar perdido.
+ */
+
+#include <stdio.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_task_wdt.h"
+#include "esp_timer.h"
+#include "esp_cpu.h"
+#include "trabalhadores.h"
+#include "log_async.h"
+
+#define TRABALHO_WDT_ITENS 64 // Itens processados entre duas alimentações do WDT
+
+// ==========================================
+// Deque com trava: o dono tira da frente, os ladrões tiram do fim
+static bool deque_inserir(trabalho_deque_t *d, const fila_item_t *item)
+{
+    bool ok = false;
+    taskENTER_CRITICAL(&d->trava);
+    if(d->n < TRABALHO_DEQUE_CAP)
+    {
+        d->itens[(d->inicio + d->n) % TRABALHO_DEQUE_CAP] = *item;
+        d->n++;
+        ok = true;
+    }
+    taskEXIT_CRITICAL(&d->trava);
+    return ok;
+}
+
+static bool deque_frente(trabalho_deque_t *d, fila_item_t *item)
+{
+    bool ok = false;
+    taskENTER_CRITICAL(&d->trava);
+    if(d->n > 0)
+    {
+        *item = d->itens[d->inicio];
+        d->inicio = (d->inicio + 1) % TRABALHO_DEQUE_CAP;
+        d->n--;
+        ok = true;
+    }
+    taskEXIT_CRITICAL(&d->trava);
+    return ok;
+}
+
+static bool deque_roubar(trabalho_deque_t *d, fila_item_t *item)
+{
+    bool ok = false;
+    taskENTER_CRITICAL(&d->trava);
+    if(d->n > 0)
+    {
+        d->n--;
+        *item = d->itens[(d->inicio + d->n) % TRABALHO_DEQUE_CAP];
+        ok = true;
+    }
+    taskEXIT_CRITICAL(&d->trava);
+    return ok;
+}
+
+// ==========================================
+// Próximo item do trabalhador: o seu deque ou um roubo, começando pelo vizinho
+static bool obter_item(trabalhadores_t *pool, trabalhador_t *t, fila_item_t *item)
+{
+    if(deque_frente(&t->deque, item))
+        return true;
+
+    for(uint32_t i = 1; i < pool->n; i++)
+    {
+        trabalhador_t *vitima = &pool->trab[(t->indice + i) % pool->n];
+        if(vitima->deque.n > 0 && deque_roubar(&vitima->deque, item)) // Leitura de n sem trava: só um filtro
+        {
+            t->stats.roubados++;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool ha_trabalho(const trabalhadores_t *pool)
+{
+    for(uint32_t k = 0; k < pool->n; k++)
+    {
+        if(pool->trab[k].deque.n > 0)
+            return true;
+    }
+    return false;
+}
+
+static void trabalhador(void *pv)
+{
+    trabalhador_t *t = pv;
+    trabalhadores_t *pool = t->pool;
+    fila_item_t item;
+
+    esp_task_wdt_add(NULL);
+
+    while(1)
+    {
+        if(obter_item(pool, t, &item))
+        {
+            int64_t inicio_us = esp_timer_get_time();
+            pool->processar(&item);
+            t->stats.ocupado_us += (uint32_t)(esp_timer_get_time() - inicio_us);
+            if(++t->stats.processados % TRABALHO_WDT_ITENS == 0)
+                esp_task_wdt_reset();
+            continue;
+        }
+        if(atomic_load(&pool->parar))
+            break;
+
+        // Anuncia o sono e confere de novo para não perder um item concorrente
+        atomic_store(&t->dormindo, true);
+        atomic_thread_fence(memory_order_seq_cst);
+        if(!ha_trabalho(pool))
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(TRABALHO_ESPERA_MS));
+        atomic_store(&t->dormindo, false);
+        esp_task_wdt_reset();
+    }
+
+    esp_task_wdt_delete(NULL);
+    atomic_fetch_sub(&pool->ativos, 1);
+    vTaskDelete(NULL);
+}
+
+// Acorda o trabalhador k se estiver dormindo; se estiver ocupado, chama um ocioso para roubar
+static void acordar(trabalhadores_t *pool, uint32_t k)
+{
+    atomic_thread_fence(memory_order_seq_cst); // Item publicado antes da leitura das flags
+    for(uint32_t i = 0; i < pool->n; i++)
+    {
+        trabalhador_t *t = &pool->trab[(k + i) % pool->n];
+        if(atomic_load_explicit(&t->dormindo, memory_order_relaxed) && atomic_exchange(&t->dormindo, false))
+        {
+            xTaskNotifyGive(t->handle);
+            return;
+        }
+    }
+}
+
+// ==========================================
+bool trabalhadores_iniciar(trabalhadores_t *pool, uint32_t n, void (*processar)(const fila_item_t *item),
+                           UBaseType_t prioridade, StackType_t *pilhas, StaticTask_t *tcbs)
+{
+    if(n == 0 || n > TRABALHADORES_MAX || processar == NULL)
+        return false;
+
+    pool->n = n;
+    pool->proximo = 0;
+    pool->processar = processar;
+    pool->relatorio_us = esp_timer_get_time();
+    atomic_store(&pool->parar, false);
+    atomic_store(&pool->ativos, 0);
+
+    for(uint32_t k = 0; k < n; k++)
+    {
+        trabalhador_t *t = &pool->trab[k];
+        *t = (trabalhador_t){ .pool = pool, .indice = k };
+        portMUX_INITIALIZE(&t->deque.trava);
+        atomic_init(&t->dormindo, false);
+        snprintf(t->nome, sizeof(t->nome), "Trab%lu", k);
+    }
+
+    // Todos os deques prontos antes do primeiro roubo
+    for(uint32_t k = 0; k < n; k++)
+    {
+        trabalhador_t *t = &pool->trab[k];
+        BaseType_t nucleo = k % portNUM_PROCESSORS;
+
+        atomic_fetch_add(&pool->ativos, 1);
+        if(pilhas != NULL && tcbs != NULL)
+            t->handle = xTaskCreateStaticPinnedToCore(trabalhador, t->nome, TRABALHADOR_PILHA, t, prioridade,
+                                                      pilhas + k * TRABALHADOR_PILHA, &tcbs[k], nucleo);
+        else if(xTaskCreatePinnedToCore(trabalhador, t->nome, TRABALHADOR_PILHA, t, prioridade,
+                                        &t->handle, nucleo) != pdPASS)
+            t->handle = NULL;
+
+        if(t->handle == NULL)
+        {
+            atomic_fetch_sub(&pool->ativos, 1);
+            pool->n = k; // Os já criados continuam atendendo
+            return false;
+        }
+    }
+    return true;
+}
+
+bool trabalhadores_enviar(trabalhadores_t *pool, const fila_item_t *item)
+{
+    for(uint32_t i = 0; i < pool->n; i++)
+    {
+        uint32_t k = pool->proximo;
+        pool->proximo = k + 1 == pool->n ? 0 : k + 1;
+        if(deque_inserir(&pool->trab[k].deque, item))
+        {
+            acordar(pool, k);
+            return true;
+        }
+    }
+    return false;
+}
+
+void trabalhadores_parar(trabalhadores_t *pool)
+{
+    // Sem notificação: um trabalhador já encerrado não tem mais handle válido,
+    // e quem dorme acorda sozinho em até TRABALHO_ESPERA_MS
+    atomic_store(&pool->parar, true);
+    while(atomic_load(&pool->ativos) > 0)
+        vTaskDelay(1);
+}
+
+void trabalhadores_total(const trabalhadores_t *pool, trabalhador_stats_t *total)
+{
+    *total = (trabalhador_stats_t){ 0 };
+    for(uint32_t k = 0; k < pool->n; k++)
+    {
+        total->processados += pool->trab[k].stats.processados;
+        total->roubados += pool->trab[k].stats.roubados;
+        total->ocupado_us += pool->trab[k].stats.ocupado_us;
+    }
+}
+
+void trabalhadores_relatorio(trabalhadores_t *pool)
+{
+    int64_t agora_us = esp_timer_get_time();
+    uint32_t janela_us = (uint32_t)(agora_us - pool->relatorio_us);
+    pool->relatorio_us = agora_us;
+
+    for(uint32_t k = 0; k < pool->n; k++)
+    {
+        trabalhador_t *t = &pool->trab[k];
+        trabalhador_stats_t s = t->stats;
+        uint32_t ocupado = s.ocupado_us - t->anterior.ocupado_us;
+        uint32_t uso = janela_us ? (uint32_t)((uint64_t)ocupado * 1000 / janela_us) : 0; // Permil
+
+        log_printf("   - %-6s núcleo %lu: %lu processados (+%lu), %lu roubados (+%lu), uso %lu.%lu%%, deque %lu\n",
+                   t->nome, k % portNUM_PROCESSORS, s.processados, s.processados - t->anterior.processados,
+                   s.roubados, s.roubados - t->anterior.roubados, uso / 10, uso % 10, t->deque.n);
+        t->anterior = s;
+    }
+}
+
+void trabalho_carga(uint32_t ciclos)
+{
+    uint32_t inicio = esp_cpu_get_cycle_count();
+    while(esp_cpu_get_cycle_count() - inicio < ciclos)
+        ;
+}
@@ -0,0 +1,87 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Pool de trabalhadores com roubo de trabalho
+ * Um alimentador (a Task2) distribui os itens em rodízio pelos deques dos
+ * trabalhadores, alternados entre os núcleos. Cada trabalhador consome a
+ * frente do seu deque; sem trabalho, rouba do fim do deque de outro. Um
+ * trabalhador ocioso é acordado quando o dono do deque que recebeu o item
+ * está ocupado, para que o excesso seja roubado.
+ */
+
+#pragma once
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "transporte.h"
+#include "sistema_config.h"
+
+#define TRABALHADORES_MAX 4
+
+_Static_assert(TRABALHADORES <= TRABALHADORES_MAX, "TRABALHADORES acima de TRABALHADORES_MAX");
+
+typedef struct
+{
+    portMUX_TYPE trava;  // Seção curta: dono e ladrões usam pontas opostas
+    fila_item_t itens[TRABALHO_DEQUE_CAP];
+    uint32_t inicio;     // Mais antigo (consumido pelo dono)
+    uint32_t n;
+} trabalho_deque_t;
+
+typedef struct
+{
+    uint32_t processados;
+    uint32_t roubados;   // Itens tirados do deque de outro trabalhador
+    uint32_t ocupado_us; // Tempo processando (contador livre de 32 bits)
+} trabalhador_stats_t;
+
+typedef struct trabalhadores trabalhadores_t;
+
+typedef struct
+{
+    trabalhadores_t *pool;
+    uint32_t indice;
+    char nome[configMAX_TASK_NAME_LEN];
+    trabalho_deque_t deque;
+    TaskHandle_t handle;
+    atomic_bool dormindo;
+    trabalhador_stats_t stats;    // Escritos só pelo trabalhador
+    trabalhador_stats_t anterior; // Leitura do relatório anterior
+} trabalhador_t;
+
+struct trabalhadores
+{
+    trabalhador_t trab[TRABALHADORES_MAX];
+    uint32_t n;
+    uint32_t proximo; // Rodízio do alimentador
+    void (*processar)(const fila_item_t *item);
+    atomic_bool parar;
+    atomic_uint ativos;
+    int64_t relatorio_us;
+};
+
+// Cria n trabalhadores (trabalhador k no núcleo k % portNUM_PROCESSORS).
+// 'pilhas' (n * TRABALHADOR_PILHA) e 'tcbs' (n) dão memória estática; NULL usa o heap.
+bool trabalhadores_iniciar(trabalhadores_t *pool, uint32_t n, void (*processar)(const fila_item_t *item),
+                           UBaseType_t prioridade, StackType_t *pilhas, StaticTask_t *tcbs);
+
+// Alimentador (uma única task): entrega o item a um deque. Retorna false se
+// todos estiverem cheios; o chamador então processa o item ele mesmo.
+bool trabalhadores_enviar(trabalhadores_t *pool, const fila_item_t *item);
+
+// Encerra os trabalhadores depois de esvaziarem os deques (uso nos benchmarks).
+void trabalhadores_parar(trabalhadores_t *pool);
+
+// Soma dos contadores de todos os trabalhadores.
+void trabalhadores_total(const trabalhadores_t *pool, trabalhador_stats_t *total);
+
+// Loga processados, roubos e utilização de cada trabalhador desde o relatório anterior.
+void trabalhadores_relatorio(trabalhadores_t *pool);
+
+// Carga sintética: ocupa a CPU por 'ciclos' ciclos do núcleo atual.
+void trabalho_carga(uint32_t ciclos);
@@ -0,0 +1,437 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Implementação do transporte entre os produtores e a Task2
+ * FILA_TRANSPORTE_QUEUE: filas FreeRTOS (cópia + seção crítica por item), uma
+ *                        por produtor e faixa, unidas por um QueueSet quando há
+ *                        mais de uma.
+ * FILA_TRANSPORTE_RING:  rings SPSC lock-free (shards.c), um conjunto de shards
+ *                        por faixa; o consumidor só é acordado por notificação
+ *                        quando está realmente bloqueado.
+ * FILA_TRANSPORTE_NOTIFICACAO: a Task1 entrega direto ao consumidor por uma
+ *                        caixa de um item + notificação da task; as filas
+ *                        FreeRTOS ficam de reserva quando a caixa está ocupada.
+ */
+
+#include <stdatomic.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "transporte.h"
+#include "shards.h"
+#include "faixas.h"
+
+_Static_assert(FAIXAS <= FAIXAS_MAX, "FAIXAS acima de FAIXAS_MAX");
+
+static faixas_t escalonador; // Só o consumidor escolhe a faixa
+
+static inline uint32_t faixa_do_item(const fila_item_t *item)
+{
+    return item->faixa < FAIXAS ? item->faixa : FAIXAS - 1;
+}
+
+#if FILA_TRANSPORTE != FILA_TRANSPORTE_QUEUE
+
+// ==========================================
+// Espera por notificação (RING e NOTIFICACAO)
+static bool receber_por_faixa(fila_item_t *item); // Sem bloquear, definida por modo
+
+static TaskHandle_t consumidor = NULL;        // Task bloqueada em transporte_receber
+static atomic_bool consumidor_esperando = false;
+
+// Acorda o consumidor se ele estiver bloqueado esperando dados
+static inline void acordar_consumidor(void)
+{
+    atomic_thread_fence(memory_order_seq_cst); // Publicação do item antes da leitura da flag
+    if(atomic_load_explicit(&consumidor_esperando, memory_order_relaxed) &&
+       atomic_exchange(&consumidor_esperando, false))
+    {
+        xTaskNotifyGive(consumidor);
+    }
+}
+
+static bool receber_notificado(fila_item_t *item, TickType_t espera)
+{
+    if(receber_por_faixa(item))
+        return true;
+    if(espera == 0)
+        return false;
+
+    consumidor = xTaskGetCurrentTaskHandle();
+    TickType_t inicio = xTaskGetTickCount();
+
+    while(1)
+    {
+        // Anuncia a espera e confere de novo para não perder um envio concorrente
+        atomic_store(&consumidor_esperando, true);
+        atomic_thread_fence(memory_order_seq_cst);
+        if(receber_por_faixa(item))
+        {
+            atomic_store(&consumidor_esperando, false);
+            return true;
+        }
+
+        TickType_t decorrido = xTaskGetTickCount() - inicio;
+        if(espera != portMAX_DELAY && decorrido >= espera)
+        {
+            atomic_store(&consumidor_esperando, false);
+            return false;
+        }
+
+        ulTaskNotifyTake(pdTRUE, espera == portMAX_DELAY ? portMAX_DELAY : espera - decorrido);
+    }
+}
+#endif
+
+#if FILA_TRANSPORTE == FILA_TRANSPORTE_QUEUE || FILA_TRANSPORTE == FILA_TRANSPORTE_NOTIFICACAO
+
+// ==========================================
+// Filas FreeRTOS (no modo NOTIFICACAO, a reserva da caixa da Task1)
+#define FILAS_CONJUNTO (FILA_TRANSPORTE == FILA_TRANSPORTE_QUEUE && (PRODUTORES > 1 || FAIXAS > 1))
+
+static const uint32_t capacidade_faixa[FAIXAS_MAX] = {
+    [FAIXA_VOLUME] = FILA_CAPACIDADE, [FAIXA_URGENTE] = FAIXA_URGENTE_CAPACIDADE
+};
+
+static QueueHandle_t filas[FAIXAS][PRODUTORES]; // Uma fila por faixa e produtor
+#if FILAS_CONJUNTO
+// O conjunto recebe um handle por item enviado e serve como contagem de itens
+// para a espera: a seleção só acorda o consumidor, que lê de qualquer fila
+// conforme a faixa escolhida. Cada handle retirado corresponde a um item lido,
+// então os handles restantes continuam cobrindo os itens restantes.
+// Não há xQueueCreateSetStatic no FreeRTOS do IDF; o conjunto sai do heap no boot.
+static QueueSetHandle_t conjunto = NULL;
+#endif
+#if FILAS_CONJUNTO || FILA_TRANSPORTE == FILA_TRANSPORTE_NOTIFICACAO
+static uint32_t proximo_produtor[FAIXAS]; // Rodízio entre os produtores da faixa
+#endif
+
+#if FILA_TRANSPORTE == FILA_TRANSPORTE_NOTIFICACAO
+// Caixa da Task1 (shard 0, produtor único): a flag passa a posse do item de um
+// lado para o outro. O caminho direto só é usado sem itens da Task1 nas filas,
+// então o item da caixa é sempre mais antigo que os da Task1 na reserva.
+static fila_item_t caixa;
+static atomic_bool caixa_cheia = false;
+static atomic_uint task1_na_fila;  // Itens da Task1 nas filas de reserva
+static uint32_t entregas_diretas;  // Escritos só pela Task1
+static uint32_t entregas_reserva;
+#endif
+
+bool transporte_init(void)
+{
+    faixas_init(&escalonador, FAIXAS, FAIXAS_ESCALONAMENTO);
+
+    for(uint32_t f = 0; f < FAIXAS; f++)
+    {
+        for(uint32_t k = 0; k < PRODUTORES; k++)
+        {
+#if ALOCACAO_ESTATICA
+            static StaticQueue_t fila_mem[FAIXAS][PRODUTORES];
+            static uint8_t buffer_volume[PRODUTORES][FILA_CAPACIDADE * sizeof(fila_item_t)];
+#if FAIXAS > 1
+            static uint8_t buffer_urgente[PRODUTORES][FAIXA_URGENTE_CAPACIDADE * sizeof(fila_item_t)];
+            uint8_t *buffer = f == FAIXA_URGENTE ? buffer_urgente[k] : buffer_volume[k];
+#else
+            uint8_t *buffer = buffer_volume[k];
+#endif
+            filas[f][k] = xQueueCreateStatic(capacidade_faixa[f], sizeof(fila_item_t), buffer, &fila_mem[f][k]);
+#else
+            filas[f][k] = xQueueCreate(capacidade_faixa[f], sizeof(fila_item_t));
+#endif
+            if(filas[f][k] == NULL)
+                return false;
+        }
+    }
+
+#if FILAS_CONJUNTO
+    conjunto = xQueueCreateSet(FILA_POSICOES);
+    if(conjunto == NULL)
+        return false;
+    for(uint32_t f = 0; f < FAIXAS; f++)
+    {
+        for(uint32_t k = 0; k < PRODUTORES; k++)
+        {
+            if(xQueueAddToSet(filas[f][k], conjunto) != pdPASS)
+                return false;
+        }
+    }
+#endif
+    return true;
+}
+
+#if FILA_TRANSPORTE == FILA_TRANSPORTE_NOTIFICACAO
+bool transporte_enviar(const fila_item_t *item)
+{
+    uint32_t k = transporte_shard(item->origem);
+
+    if(k == 0 && atomic_load_explicit(&task1_na_fila, memory_order_acquire) == 0 &&
+       !atomic_load_explicit(&caixa_cheia, memory_order_acquire))
+    {
+        // Caminho direto: cópia para a caixa, sem seção crítica de fila
+        caixa = *item;
+        atomic_store_explicit(&caixa_cheia, true, memory_order_release);
+        entregas_diretas++;
+        acordar_consumidor();
+        return true;
+    }
+
+    // Reserva: a contagem sobe antes do envio para o caminho direto não
+    // ultrapassar um item que o consumidor ainda não leu
+    if(k == 0)
+        atomic_fetch_add(&task1_na_fila, 1);
+    if(xQueueSend(filas[faixa_do_item(item)][k], item, 0) != pdTRUE)
+    {
+        if(k == 0)
+            atomic_fetch_sub(&task1_na_fila, 1);
+        return false;
+    }
+    if(k == 0)
+        entregas_reserva++;
+    acordar_consumidor();
+    return true;
+}
+#else
+bool transporte_enviar(const fila_item_t *item)
+{
+    return xQueueSend(filas[faixa_do_item(item)][transporte_shard(item->origem)], item, 0) == pdTRUE;
+}
+#endif
+
+uint32_t transporte_enviar_lote(const fila_item_t *itens, uint32_t n)
+{
+    uint32_t enviados = 0;
+    while(enviados < n && transporte_enviar(&itens[enviados]))
+        enviados++;
+    return enviados;
+}
+
+#if FILAS_CONJUNTO || FILA_TRANSPORTE == FILA_TRANSPORTE_NOTIFICACAO
+// Rodízio entre os produtores da faixa escolhida pelo escalonador
+static bool receber_por_faixa(fila_item_t *item)
+{
+    bool pronta[FAIXAS_MAX] = { false };
+    for(uint32_t f = 0; f < FAIXAS; f++)
+    {
+        for(uint32_t k = 0; k < PRODUTORES && !pronta[f]; k++)
+            pronta[f] = uxQueueMessagesWaiting(filas[f][k]) > 0;
+    }
+
+#if FILA_TRANSPORTE == FILA_TRANSPORTE_NOTIFICACAO
+    // A caixa é conferida depois das filas: se um item da Task1 já estava na
+    // reserva, a caixa que ele encontrou cheia continua cheia aqui
+    bool na_caixa = atomic_load_explicit(&caixa_cheia, memory_order_acquire);
+    if(na_caixa)
+        pronta[faixa_do_item(&caixa)] = true;
+#endif
+
+    int f = faixas_escolher(&escalonador, pronta);
+    if(f < 0)
+        return false;
+#if FILA_TRANSPORTE == FILA_TRANSPORTE_NOTIFICACAO
+    if(na_caixa && faixa_do_item(&caixa) == (uint32_t)f)
+    {
+        *item = caixa;
+        atomic_store_explicit(&caixa_cheia, false, memory_order_release);
+        return true;
+    }
+#endif
+    for(uint32_t i = 0; i < PRODUTORES; i++)
+    {
+        uint32_t k = proximo_produtor[f];
+        proximo_produtor[f] = k + 1 == PRODUTORES ? 0 : k + 1;
+        if(xQueueReceive(filas[f][k], item, 0) == pdTRUE)
+        {
+#if FILA_TRANSPORTE == FILA_TRANSPORTE_NOTIFICACAO
+            if(k == 0)
+                atomic_fetch_sub(&task1_na_fila, 1);
+#endif
+            return true;
+        }
+    }
+    return false;
+}
+#endif
+
+bool transporte_receber(fila_item_t *item, TickType_t espera)
+{
+#if FILA_TRANSPORTE == FILA_TRANSPORTE_NOTIFICACAO
+    return receber_notificado(item, espera);
+#elif FILAS_CONJUNTO
+    return xQueueSelectFromSet(conjunto, espera) != NULL && receber_por_faixa(item);
+#else
+    if(xQueueReceive(filas[0][0], item, espera) != pdTRUE)
+        return false;
+    escalonador.atendidos[0]++;
+    return true;
+#endif
+}
+
+uint32_t transporte_receber_lote(fila_item_t *itens, uint32_t n)
+{
+    uint32_t lidos = 0;
+    while(lidos < n && transporte_receber(&itens[lidos], 0))
+        lidos++;
+    return lidos;
+}
+
+void transporte_reset(void)
+{
+#if FILAS_CONJUNTO || FILA_TRANSPORTE == FILA_TRANSPORTE_NOTIFICACAO
+    // xQueueReset deixaria handles órfãos no conjunto (e a contagem da caixa
+    // desatualizada): esvazia pelo caminho de recepção
+    fila_item_t item;
+    while(transporte_receber(&item, 0))
+        ;
+#else
+    xQueueReset(filas[0][0]);
+#endif
+}
+
+static uint32_t ocupacao_faixa(uint32_t f)
+{
+    uint32_t total = 0;
+    for(uint32_t k = 0; k < PRODUTORES; k++)
+        total += uxQueueMessagesWaiting(filas[f][k]);
+#if FILA_TRANSPORTE == FILA_TRANSPORTE_NOTIFICACAO
+    if(atomic_load_explicit(&caixa_cheia, memory_order_acquire) && faixa_do_item(&caixa) == f)
+        total++;
+#endif
+    return total;
+}
+
+#if FILA_TRANSPORTE == FILA_TRANSPORTE_NOTIFICACAO
+void transporte_entregas(uint32_t *diretas, uint32_t *reserva)
+{
+    *diretas = entregas_diretas;
+    *reserva = entregas_reserva;
+}
+#endif
+
+#elif FILA_TRANSPORTE == FILA_TRANSPORTE_RING
+
+// ==========================================
+// Rings SPSC, um por produtor em cada faixa
+_Static_assert(PRODUTORES <= SHARDS_MAX, "PRODUTORES acima de SHARDS_MAX");
+
+static shards_t shards[FAIXAS];
+static fila_item_t buffer_volume[PRODUTORES * FILA_CAPACIDADE];
+#if FAIXAS > 1
+static fila_item_t buffer_urgente[PRODUTORES * FAIXA_URGENTE_CAPACIDADE];
+#endif
+
+// Lê um item da faixa escolhida pelo escalonador
+static bool receber_por_faixa(fila_item_t *item)
+{
+#if FAIXAS > 1
+    bool pronta[FAIXAS_MAX] = { false };
+    for(uint32_t f = 0; f < FAIXAS; f++)
+        pronta[f] = shards_ocupacao(&shards[f]) > 0;
+
+    int f = faixas_escolher(&escalonador, pronta);
+    return f >= 0 && shards_pop(&shards[f], item);
+#else
+    if(!shards_pop(&shards[0], item))
+        return false;
+    escalonador.atendidos[0]++;
+    return true;
+#endif
+}
+
+bool transporte_init(void)
+{
+    faixas_init(&escalonador, FAIXAS, FAIXAS_ESCALONAMENTO);
+#if FAIXAS > 1
+    if(!shards_init(&shards[FAIXA_URGENTE], buffer_urgente, PRODUTORES, FAIXA_URGENTE_CAPACIDADE, FILA_MESCLA))
+        return false;
+#endif
+    return shards_init(&shards[FAIXA_VOLUME], buffer_volume, PRODUTORES, FILA_CAPACIDADE, FILA_MESCLA);
+}
+
+bool transporte_enviar(const fila_item_t *item)
+{
+    if(!shards_push(&shards[faixa_do_item(item)], transporte_shard(item->origem), item))
+        return false;
+    acordar_consumidor();
+    return true;
+}
+
+uint32_t transporte_enviar_lote(const fila_item_t *itens, uint32_t n)
+{
+    if(n == 0)
+        return 0;
+    uint32_t enviados = shards_push_lote(&shards[faixa_do_item(&itens[0])], transporte_shard(itens[0].origem), itens, n);
+    if(enviados > 0)
+        acordar_consumidor();
+    return enviados;
+}
+
+bool transporte_receber(fila_item_t *item, TickType_t espera)
+{
+    return receber_notificado(item, espera);
+}
+
+uint32_t transporte_receber_lote(fila_item_t *itens, uint32_t n)
+{
+#if FAIXAS > 1
+    uint32_t lidos = 0;
+    while(lidos < n && receber_por_faixa(&itens[lidos]))
+        lidos++;
+    return lidos;
+#else
+    uint32_t lidos = shards_pop_lote(&shards[0], itens, n);
+    escalonador.atendidos[0] += lidos;
+    return lidos;
+#endif
+}
+
+void transporte_reset(void)
+{
+    for(uint32_t f = 0; f < FAIXAS; f++)
+        shards_limpar(&shards[f]);
+}
+
+static uint32_t ocupacao_faixa(uint32_t f)
+{
+    return shards_ocupacao(&shards[f]);
+}
+
+#else
+#error "FILA_TRANSPORTE inválido"
+#endif
+
+void transporte_produtor_removido(uint32_t origem)
+{
+#if FILA_TRANSPORTE == FILA_TRANSPORTE_NOTIFICACAO
+    // Removida à força entre a contagem e o xQueueSend, a Task1 deixaria
+    // task1_na_fila acima do real e o caminho direto desligado para sempre.
+    // Sem a Task1 e no consumidor, as filas não mudam durante a recontagem.
+    if(transporte_shard(origem) != 0)
+        return;
+    uint32_t n = 0;
+    for(uint32_t f = 0; f < FAIXAS; f++)
+        n += uxQueueMessagesWaiting(filas[f][0]);
+    atomic_store_explicit(&task1_na_fila, n, memory_order_release);
+#else
+    (void)origem; // Nos demais modos o produtor não guarda estado no transporte
+#endif
+}
+
+// ==========================================
+uint32_t transporte_ocupacao(void)
+{
+    uint32_t total = 0;
+    for(uint32_t f = 0; f < FAIXAS; f++)
+        total += ocupacao_faixa(f);
+    return total;
+}
+
+void transporte_faixas(uint32_t atendidos[FAIXAS], uint32_t ocupacao[FAIXAS])
+{
+    for(uint32_t f = 0; f < FAIXAS; f++)
+    {
+        atendidos[f] = escalonador.atendidos[f];
+        ocupacao[f] = ocupacao_faixa(f);
+    }
+}
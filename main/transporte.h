@@ -0,0 +1,81 @@
+/*
+ * SPDX-FileCopyrightText: 2010-2025 Cleber Dilenes
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ *
+ * Descrição: Transporte de dados entre os produtores e a Task2 (consumidor)
+ * Substitui o uso direto da fila FreeRTOS; a implementação é escolhida em
+ * tempo de compilação por FILA_TRANSPORTE (sistema_config.h). Com PRODUTORES > 1
+ * cada produtor tem seu shard, escolhido pela origem do item; com FAIXAS > 1
+ * cada faixa de prioridade tem seus próprios shards, e a recepção segue o
+ * escalonador de faixas (faixas.c).
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "sistema_config.h"
+#include "bloco_dados.h"
+
+// Origens das amostras (cada uma com sua própria sequência)
+#define ORIGEM_TASK1      0 // Task1 periódica
+#define ORIGEM_AMOSTRAGEM 1 // ISR do gptimer
+#define ORIGEM_PRODUTOR(k) ((k) == 0 ? ORIGEM_TASK1 : ORIGEM_AMOSTRAGEM + (k)) // Produtor k (0 = Task1)
+
+// Item transportado pela fila: registro de 16 bytes, campos de 32 bits
+// alinhados e sem enchimento implícito (2 itens por linha de cache de 32 B)
+typedef struct
+{
+    uint32_t seq;        // Sequência por origem (detecção de perdas em sequencia.c)
+    uint32_t t_producao; // esp_timer_get_time() no envio (µs, 32 bits); base da latência
+    int valor;           // Dado gerado pela Task1
+    uint16_t origem;     // ORIGEM_*
+    uint16_t faixa;      // FAIXA_VOLUME / FAIXA_URGENTE
+#if FILA_ZERO_COPIA
+    bloco_dados_t *bloco; // Quadro de dados passado por ponteiro (posse vai para o consumidor)
+#endif
+} fila_item_t;
+
+_Static_assert(FILA_ZERO_COPIA || sizeof(fila_item_t) == 16, "fila_item_t deve ter 16 bytes");
+
+// Shard do produtor que gera a origem: a Task1 (periódica ou amostragem) usa o
+// shard 0 e o produtor extra k, o shard k. Cada shard tem um único produtor.
+static inline uint32_t transporte_shard(uint32_t origem)
+{
+    return origem > ORIGEM_AMOSTRAGEM ? (origem - ORIGEM_AMOSTRAGEM) % PRODUTORES : 0;
+}
+
+// Cria a fila/ring. Retorna false se faltar memória.
+bool transporte_init(void);
+
+// Produtor: envia sem bloquear para o shard da origem. Retorna false se estiver cheio.
+bool transporte_enviar(const fila_item_t *item);
+
+// Produtor: envia até n itens de uma vez (mesma origem e faixa). Retorna quantos foram aceitos.
+uint32_t transporte_enviar_lote(const fila_item_t *itens, uint32_t n);
+
+// Consumidor: recebe um item, bloqueando por até 'espera' ticks.
+bool transporte_receber(fila_item_t *item, TickType_t espera);
+
+// Consumidor: recebe até n itens sem bloquear. Retorna quantos foram lidos.
+uint32_t transporte_receber_lote(fila_item_t *itens, uint32_t n);
+
+// Consumidor: descarta o conteúdo da fila (recuperação moderada).
+void transporte_reset(void);
+
+// Recuperação: o produtor da origem foi removido e ainda não foi recriado.
+// Recalcula o estado que ele mantinha no transporte. Chamar no consumidor.
+void transporte_produtor_removido(uint32_t origem);
+
+// Número de itens aguardando na fila (todos os shards).
+uint32_t transporte_ocupacao(void);
+
+// Itens entregues pelo escalonador e aguardando, por faixa (uso no logger).
+void transporte_faixas(uint32_t atendidos[FAIXAS], uint32_t ocupacao[FAIXAS]);
+
+#if FILA_TRANSPORTE == FILA_TRANSPORTE_NOTIFICACAO
+// Envios da Task1 pela caixa (notificação direta) e pelas filas de reserva.
+void transporte_entregas(uint32_t *diretas, uint32_t *reserva);
+#endif
@@ -5,6 +5,9 @@ import logging
 from typing import Callable
 
 import pytest
+from log_decoder import DecodificadorLog
+from log_decoder import codificar_quadro
+from log_decoder import escrever_varint
 from pytest_embedded_idf.dut import IdfDut
 from pytest_embedded_qemu.app import QemuApp
 from pytest_embedded_qemu.dut import QemuDut
@@ -57,3 +60,35 @@ def test_hello_world_host(app: QemuApp, dut: QemuDut) -> None:
     verify_elf_sha256_embedding(app, sha256_reported)
 
     dut.expect('Hello world!')
+
+
+@pytest.mark.host_test
+def test_log_decoder_binario() -> None:
+    fmt = '{Cleber Dilenes - RM:89056} [FILA OK] Valor %d enviado para a fila\n'
+    enderecos = {0x3F401234: fmt}
+    fluxo = b'texto de boot\n\x00' + codificar_quadro(escrever_varint(0) + escrever_varint(2) + (0x3F401234).to_bytes(4, 'little'))
+    for valor in range(1000):
+        fluxo += codificar_quadro(escrever_varint(2) + escrever_varint(valor << 1))
+
+    decodificador = DecodificadorLog(enderecos.__getitem__)
+    linhas = list(decodificador.alimentar(fluxo))
+
+    assert linhas[0] == 'texto de boot\n'
+    assert linhas[1:] == [fmt % v for v in range(1000)]
+    assert decodificador.erros == 0
+    assert decodificador.reducao() >= 10
+
+
+@pytest.mark.esp32
+@pytest.mark.generic
+def test_heap_regime_permanente(dut: IdfDut) -> None:
+    # O primeiro relatório do logger inclui as alocações da inicialização
+    dut.expect(r'\[HEAP\] Alocações no ciclo: \d+', timeout=10)
+    for _ in range(3):
+        alocacoes = int(dut.expect(r'\[HEAP\] Alocações no ciclo: (\d+)', timeout=10).group(1))
+        assert alocacoes == 0
+    # Duas linhas: perfil/tipo de boot e depois os marcos de tempo ("estático" não casa com \w em bytes)
+    perfil = dut.expect(r'Boot \((\S+), (\w+) #\d+\)', timeout=10)
+    boot = dut.expect(r'Boot: .* primeira amostra em (\d+) us', timeout=10)
+    logging.info(f'Perfil {perfil.group(1).decode()} ({perfil.group(2).decode()}): '
+                 f'primeira amostra em {int(boot.group(1))} us')